@@ -0,0 +1,355 @@
+#include "alg_association.h"
+#include "alg_reference_point.h"
+#include "alg_niche_state.h"
+#include "alg_population.h"
+#include "aux_math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace
+{
+const size_t LeafSize = 32;
+const size_t BlockSize = 64; // individuals associated at once
+const double CosineMargin = 1e-9; // directions this close to the best cosine are compared exactly
+
+inline double Dot(const double *a, const double *b, size_t M)
+{
+	double s = 0;
+	for (size_t i=0; i<M; i+=1) s += a[i]*b[i];
+	return s;
+}
+}
+
+// ----------------------------------------------------------------------
+CAssociation::CAssociation(const vector<CReferencePoint> &rps, EEngine engine):
+	engine_(engine),
+	M_(rps.empty() ? 0 : rps[0].pos().size())
+{
+	if (engine_ == asBruteForce || rps.empty()) return;
+
+	vector<double> units(rps.size()*M_);
+	for (size_t r=0; r<rps.size(); r+=1)
+	{
+		copy(rps[r].unit_direction().begin(), rps[r].unit_direction().end(), units.begin()+r*M_);
+	}
+
+	vector<size_t> order(rps.size());
+	for (size_t r=0; r<order.size(); r+=1) order[r] = r;
+
+	if (engine_ == asBallTree) Build(&order, units, 0, order.size());
+
+	rp_index_ = order;
+	dirs_.resize(units.size());
+	for (size_t k=0; k<order.size(); k+=1)
+	{
+		copy(units.begin()+order[k]*M_, units.begin()+(order[k]+1)*M_, dirs_.begin()+k*M_);
+	}
+}
+// ----------------------------------------------------------------------
+void CAssociation::Nearest(const vector<CReferencePoint> &rps, const CPopulation &pop, const size_t *members, size_t n,
+						   size_t *nearest, double *distances, SWorkspace *ws) const
+{
+	SWorkspace temporary;
+	if (!ws) ws = &temporary;
+
+	if (engine_ != asDense)
+	{
+		for (size_t i=0; i<n; i+=1)
+		{
+			CArrayView<const double> point = pop[ members[i] ].conv_objs();
+			nearest[i] = (engine_ == asBallTree ? NearestBallTree(rps, point, &distances[i], ws) : NearestBruteForce(rps, point, &distances[i]));
+		}
+		return;
+	}
+
+	for (size_t first=0; first<n; first+=BlockSize)
+	{
+		size_t block = min(BlockSize, n-first);
+		ws->points.resize(block*M_);
+		for (size_t i=0; i<block; i+=1)
+		{
+			const CIndividual::TObjVec &f = pop[ members[first+i] ].conv_objs();
+			copy(f.begin(), f.end(), ws->points.begin()+i*M_);
+		}
+		NearestDense(rps, ws->points.data(), block, nearest+first, distances+first, ws);
+	}
+}
+// ----------------------------------------------------------------------
+// Build():
+//
+// Split the directions order[first, last) at the median of the coordinate
+// with the largest spread until a node has at most LeafSize directions.
+// Return the index of the node.
+// ----------------------------------------------------------------------
+size_t CAssociation::Build(vector<size_t> *porder, const vector<double> &units, size_t first, size_t last)
+{
+	vector<size_t> &order = *porder;
+
+	size_t id = nodes_.size();
+	nodes_.push_back(SNode());
+	centers_.resize(nodes_.size()*M_, 0.0);
+
+	double *center = &centers_[id*M_];
+	vector<double> lo(M_, numeric_limits<double>::max()), hi(M_, -numeric_limits<double>::max());
+	for (size_t k=first; k<last; k+=1)
+	{
+		const double *u = &units[order[k]*M_];
+		for (size_t i=0; i<M_; i+=1)
+		{
+			center[i] += u[i]/(last-first);
+			lo[i] = min(lo[i], u[i]);
+			hi[i] = max(hi[i], u[i]);
+		}
+	}
+
+	// the node is a cone around the unit center direction
+	double len = MathAux::length(CArrayView<const double>(center, M_));
+	for (size_t i=0; i<M_; i+=1) center[i] /= len;
+
+	double min_cos = 1;
+	for (size_t k=first; k<last; k+=1)
+	{
+		min_cos = min(min_cos, Dot(center, &units[order[k]*M_], M_));
+	}
+	min_cos = max(-1.0, min_cos - CosineMargin); // a little wider against rounding
+
+	SNode node = { min_cos, sqrt(1 - min_cos*min_cos), first, last, 0, 0 };
+	if (last-first > LeafSize)
+	{
+		size_t split_dim = 0;
+		for (size_t i=1; i<M_; i+=1)
+		{
+			if (hi[i]-lo[i] > hi[split_dim]-lo[split_dim]) split_dim = i;
+		}
+
+		size_t mid = first + (last-first)/2;
+		nth_element(order.begin()+first, order.begin()+mid, order.begin()+last,
+			[&](size_t a, size_t b) { return units[a*M_+split_dim] < units[b*M_+split_dim]; });
+
+		node.left = Build(porder, units, first, mid);
+		node.right = Build(porder, units, mid, last);
+	}
+	nodes_[id] = node;
+
+	return id;
+
+}// CAssociation::Build()
+// ----------------------------------------------------------------------
+void CAssociation::operator()(CNicheState *niche_state, const CPopulation &pop, const CNondominatedSort::TFronts &fronts, SWorkspace *ws) const
+{
+	if (engine_ == asBruteForce)
+	{
+		Associate(niche_state, pop, fronts);
+		return;
+	}
+
+	const vector<CReferencePoint> &rps = niche_state->rps();
+
+	size_t nearest[BlockSize];
+	double distances[BlockSize];
+	for (size_t t=0; t<fronts.size(); t+=1)
+	{
+		for (size_t first=0; first<fronts[t].size(); first+=BlockSize)
+		{
+			size_t n = min(BlockSize, fronts[t].size()-first);
+			Nearest(rps, pop, &fronts[t][first], n, nearest, distances, ws);
+
+			for (size_t i=0; i<n; i+=1)
+			{
+				if (t+1 != fronts.size()) // associating members in St/Fl (only counting)
+				{
+					niche_state->AddMember(nearest[i]);
+				}
+				else
+				{
+					niche_state->AddPotentialMember(nearest[i], fronts[t][first+i], distances[i]);
+				}
+			}
+		}
+	}
+}
+// ----------------------------------------------------------------------
+size_t CAssociation::Nearest(const vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance) const
+{
+	if (engine_ == asBruteForce) return NearestBruteForce(rps, point, distance);
+
+	SWorkspace ws;
+	if (engine_ == asBallTree) return NearestBallTree(rps, point, distance, &ws);
+
+	size_t nearest = 0;
+	NearestDense(rps, point.data(), 1, &nearest, distance, &ws);
+	return nearest;
+}
+// ----------------------------------------------------------------------
+size_t CAssociation::NearestBruteForce(const vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance) const
+{
+	size_t min_rp = rps.size();
+	double min_dist = numeric_limits<double>::max();
+	for (size_t r=0; r<rps.size(); r+=1)
+	{
+		double d = MathAux::PerpendicularDistance(rps[r].pos(), rps[r].squared_norm(), point);
+		if (d < min_dist)
+		{
+			min_dist = d;
+			min_rp = r;
+		}
+	}
+
+	*distance = min_dist;
+	return min_rp;
+}
+// ----------------------------------------------------------------------
+size_t CAssociation::NearestBallTree(const vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance, SWorkspace *ws) const
+{
+	double len = MathAux::length(point);
+	bool negative = false;
+	for (size_t i=0; i<point.size(); i+=1) negative = negative || point[i] < 0;
+
+	if (len == 0 || negative || nodes_.empty() || !(len < numeric_limits<double>::infinity()))
+	{
+		return NearestBruteForce(rps, point, distance);
+	}
+
+	vector<double> &q = ws->unit_point;
+	q.resize(M_);
+	for (size_t i=0; i<M_; i+=1) q[i] = point[i]/len;
+
+	// ---------- branch and bound on the cosine ----------
+	// A node is skipped if the angle between q and its center exceeds its half
+	// angle plus the angle of the threshold (the best cosine minus the margin).
+	double best = -numeric_limits<double>::max(), cos_threshold = 0, sin_threshold = 1;
+	ws->candidates.clear();
+	ws->stack.assign(1, 0);
+	while (!ws->stack.empty())
+	{
+		size_t id = ws->stack.back();
+		ws->stack.pop_back();
+
+		const SNode &node = nodes_[id];
+		if (Dot(q.data(), &centers_[id*M_], M_) < node.cos_half_angle*cos_threshold - node.sin_half_angle*sin_threshold) continue;
+
+		if (node.left == 0) // leaf
+		{
+			for (size_t k=node.first; k<node.last; k+=1)
+			{
+				double c = Dot(q.data(), &dirs_[k*M_], M_);
+				if (c > best)
+				{
+					best = c;
+					cos_threshold = max(0.0, best - CosineMargin);
+					sin_threshold = sqrt(1 - cos_threshold*cos_threshold);
+				}
+				if (c >= best - CosineMargin) ws->candidates.push_back(make_pair(rp_index_[k], c));
+			}
+		}
+		else // visit the more promising child first
+		{
+			double cl = Dot(q.data(), &centers_[node.left*M_], M_),
+				   cr = Dot(q.data(), &centers_[node.right*M_], M_);
+			ws->stack.push_back(cl < cr ? node.left : node.right);
+			ws->stack.push_back(cl < cr ? node.right : node.left);
+		}
+	}
+
+	return ExactNearest(rps, point, distance, ws, best - CosineMargin);
+
+}// CAssociation::NearestBallTree()
+// ----------------------------------------------------------------------
+// NearestDense():
+//
+// The nearest reference points of n points (rows of a matrix with M
+// columns). The dot products with the unit directions are the cosines
+// times the length of the point.
+// ----------------------------------------------------------------------
+void CAssociation::NearestDense(const vector<CReferencePoint> &rps, const double *points, size_t n,
+								size_t *nearest, double *distances, SWorkspace *ws) const
+{
+	const size_t R = rps.size();
+	ws->dots.resize(n*R);
+	MathAux::DotProducts(points, n, dirs_.data(), R, M_, ws->dots.data());
+
+	for (size_t i=0; i<n; i+=1)
+	{
+		CArrayView<const double> point(points+i*M_, M_);
+
+		double len = MathAux::length(point);
+		bool negative = false;
+		for (size_t m=0; m<M_; m+=1) negative = negative || point[m] < 0;
+
+		if (len == 0 || negative || !(len < numeric_limits<double>::infinity()))
+		{
+			nearest[i] = NearestBruteForce(rps, point, &distances[i]);
+			continue;
+		}
+
+		const double *dots = &ws->dots[i*R];
+		const double threshold = *max_element(dots, dots+R) - CosineMargin*len;
+
+		ws->candidates.clear();
+		for (size_t r=0; r<R; r+=1)
+		{
+			if (dots[r] >= threshold) ws->candidates.push_back(make_pair(r, dots[r]));
+		}
+		nearest[i] = ExactNearest(rps, point, &distances[i], ws, threshold);
+	}
+}
+// ----------------------------------------------------------------------
+// ExactNearest():
+//
+// Among the candidates whose cosine is at least the threshold, the one with
+// the smallest perpendicular distance. They are compared in the order of
+// the brute-force scan, so ties are broken in the same way.
+// ----------------------------------------------------------------------
+size_t CAssociation::ExactNearest(const vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance,
+								  SWorkspace *ws, double threshold) const
+{
+	sort(ws->candidates.begin(), ws->candidates.end());
+
+	size_t min_rp = rps.size();
+	double min_dist = numeric_limits<double>::max();
+	for (size_t j=0; j<ws->candidates.size(); j+=1)
+	{
+		if (ws->candidates[j].second < threshold) continue;
+
+		size_t r = ws->candidates[j].first;
+		double d = MathAux::PerpendicularDistance(rps[r].pos(), rps[r].squared_norm(), point);
+		if (d < min_dist)
+		{
+			min_dist = d;
+			min_rp = r;
+		}
+	}
+
+	*distance = min_dist;
+	return min_rp;
+}
+// ----------------------------------------------------------------------
+const char * CAssociation::EngineName(EEngine engine)
+{
+	switch (engine)
+	{
+	case asBruteForce: return "BruteForce";
+	case asBallTree: return "BallTree";
+	case asDense: return "Dense";
+	default: return "";
+	}
+}
+// ----------------------------------------------------------------------
+bool CAssociation::ParseEngine(const string &name, EEngine *engine)
+{
+	const EEngine engines[] = { asBruteForce, asBallTree, asDense };
+	for (size_t i=0; i<sizeof(engines)/sizeof(engines[0]); i+=1)
+	{
+		if (name == EngineName(engines[i]))
+		{
+			*engine = engines[i];
+			return true;
+		}
+	}
+	return false;
+}
+// ----------------------------------------------------------------------
@@ -0,0 +1,97 @@
+#ifndef ASSOCIATION__
+#define ASSOCIATION__
+
+#include <vector>
+#include <string>
+#include "alg_nondominated_sort.h"
+#include "aux_array_view.h"
+
+class CReferencePoint;
+class CPopulation;
+class CNicheState;
+
+// ----------------------------------------------------------------------------------
+//		CAssociation
+//
+// Associates individuals with their nearest reference point (the one with the smallest
+// perpendicular distance, Algorithm 3 in the original paper). It is built once per run
+// from the set of reference points and used in every generation on (copies of) the
+// same set, in the same order.
+//
+// All engines return the same reference point and distance as the brute-force scan
+// (Associate()), including the tie-breaking (the first reference point wins).
+//
+// asBallTree: for a point p, the perpendicular distance to a direction u is
+// |p|*sqrt(1 - cos^2(p, u)), so the nearest reference point has the largest cosine
+// similarity. The unit directions are kept in a ball tree on the unit sphere (each node
+// is a cone around its mean direction) and searched by branch and bound; the few
+// directions whose cosine is within a small margin of the best are then compared with
+// the exact distance. Points with negative coordinates (which cannot
+// occur after normalization unless the hyperplane is degenerate) fall back to the scan.
+//
+// asDense: the same idea without the tree. The dot products of a block of individuals
+// with all the unit directions are computed at once (a small matrix product,
+// MathAux::DotProducts()). It is the default: in BENCH_Associate it is faster
+// than the tree for all the settings of the original paper.
+// ----------------------------------------------------------------------------------
+class CAssociation
+{
+public:
+	enum EEngine
+	{
+		asBruteForce,	// all the reference points for every individual, O(N*|R|*M)
+		asBallTree,		// branch and bound over unit directions
+		asDense			// dot products with all unit directions, blocked over individuals
+	};
+
+	explicit CAssociation(const std::vector<CReferencePoint> &rps, EEngine engine = asDense);
+
+	// Scratch buffers of the searches. Passing the same workspace to every call
+	// avoids allocating them again (without one, a temporary one is used).
+	struct SWorkspace
+	{
+		std::vector<double> unit_point;
+		std::vector<std::size_t> stack;
+		std::vector< std::pair<std::size_t, double> > candidates; // (reference point, cosine)
+		std::vector<double> points, dots; // a block of individuals and their dot products (dense)
+	};
+
+	EEngine Engine() const { return engine_; }
+
+	// fills the niches of niche_state (whose reference points are the ones given to the constructor)
+	void operator()(CNicheState *niche_state, const CPopulation &pop, const CNondominatedSort::TFronts &fronts, SWorkspace *ws = 0) const;
+
+	// the index of the nearest reference point of a point and the perpendicular distance to it
+	std::size_t Nearest(const std::vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance) const;
+	// the same for the converted objectives of pop[members[0..n-1]]
+	void Nearest(const std::vector<CReferencePoint> &rps, const CPopulation &pop, const std::size_t *members, std::size_t n,
+				 std::size_t *nearest, double *distances, SWorkspace *ws = 0) const;
+
+	// engine names used in experiment files (e.g. "BallTree")
+	static const char * EngineName(EEngine engine);
+	static bool ParseEngine(const std::string &name, EEngine *engine);
+
+private:
+	struct SNode
+	{
+		double cos_half_angle, sin_half_angle; // the cone around the center that holds the directions
+		std::size_t first, last, // the directions dirs_[first, last)
+					left, right; // children (0 for a leaf, since the root is node 0)
+	};
+
+	std::size_t Build(std::vector<std::size_t> *order, const std::vector<double> &units, std::size_t first, std::size_t last);
+	std::size_t NearestBruteForce(const std::vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance) const;
+	std::size_t NearestBallTree(const std::vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance, SWorkspace *ws) const;
+	void NearestDense(const std::vector<CReferencePoint> &rps, const double *points, std::size_t n,
+					  std::size_t *nearest, double *distances, SWorkspace *ws) const;
+	std::size_t ExactNearest(const std::vector<CReferencePoint> &rps, CArrayView<const double> point, double *distance, SWorkspace *ws, double threshold) const;
+
+	EEngine engine_;
+	std::size_t M_;
+	std::vector<SNode> nodes_;
+	std::vector<double> centers_, // unit center directions, one row per node
+						dirs_; // unit directions (one row per reference point, in the order of the leaves for asBallTree)
+	std::vector<std::size_t> rp_index_; // rp_index_[k]: the reference point of dirs_ row k
+};
+
+#endif
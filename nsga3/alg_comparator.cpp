@@ -1,26 +1,226 @@
 
 #include "alg_comparator.h"
 #include "alg_individual.h"
+#include "alg_population.h"
 
-// ----------------------------------------------------------------------------------
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DOMINANCE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+using std::size_t;
 
-CParetoDominate ParetoDominate;
+// ----------------------------------------------------------------------------------
+//						BComparator
+// ----------------------------------------------------------------------------------
+bool BComparator::AnyOf(const CPopulation &pop, const size_t *members, size_t n, const CIndividual &r) const
+{
+	for (size_t j=n; j>0; j-=1)
+	{
+		if ( (*this)(pop[ members[j-1] ], r) ) return true;
+	}
+	return false;
+}
 
 // ----------------------------------------------------------------------------------
 //						CParetoDominate
 // ----------------------------------------------------------------------------------
 bool CParetoDominate::operator()(const CIndividual &l, const CIndividual &r) const
+{
+	return ParetoDominates(l.objs().data(), r.objs().data(), l.objs().size());
+
+}// CParetoDominate::operator()
+// ----------------------------------------------------------------------------------
+bool CParetoDominate::AnyOf(const CPopulation &pop, const size_t *members, size_t n, const CIndividual &r) const
+{
+	return AnyParetoDominates(pop.objs_data(), members, n, r.objs().data(), pop.num_objectives());
+}
+
+
+// ----------------------------------------------------------------------------------
+//						Scalar kernels
+// ----------------------------------------------------------------------------------
+static bool DominatesScalar(const double *l, const double *r, size_t M)
 {
 	bool better = false;
-	for (size_t f=0; f<l.objs().size(); f+=1)
+	for (size_t f=0; f<M; f+=1)
 	{
-		if (l.objs()[f] > r.objs()[f])
+		if (l[f] > r[f])
 			return false;
-		else if (l.objs()[f] < r.objs()[f])
+		else if (l[f] < r[f])
 			better = true;
 	}
 
 	return better;
+}
+// ----------------------------------------------------------------------------------
+static bool AnyDominatesScalar(const double *matrix, const size_t *rows, size_t n, const double *r, size_t M)
+{
+	for (size_t j=n; j>0; j-=1)
+	{
+		if (DominatesScalar(matrix + rows[j-1]*M, r, M)) return true;
+	}
+	return false;
+}
 
-}// CParetoDominate::operator()
+
+#ifdef DOMINANCE_X86_SIMD
+// ----------------------------------------------------------------------------------
+//						AVX2 kernels (4 objectives per instruction)
+// ----------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static bool DominatesAVX2(const double *l, const double *r, size_t M)
+{
+	int better = 0;
+	size_t f = 0;
+	for (; f+4<=M; f+=4)
+	{
+		__m256d a = _mm256_loadu_pd(l+f), b = _mm256_loadu_pd(r+f);
+		if (_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ))) return false;
+		better |= _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ));
+	}
+	for (; f<M; f+=1)
+	{
+		if (l[f] > r[f]) return false;
+		better |= (l[f] < r[f]);
+	}
+
+	return better != 0;
+}
+// ----------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static bool AnyDominatesAVX2(const double *matrix, const size_t *rows, size_t n, const double *r, size_t M)
+{
+	for (size_t j=n; j>0; j-=1)
+	{
+		if (DominatesAVX2(matrix + rows[j-1]*M, r, M)) return true;
+	}
+	return false;
+}
+
+// ----------------------------------------------------------------------------------
+//						AVX-512 kernels (8 objectives per instruction)
+//
+// The tail is handled by masked loads and compares.
+// ----------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+static inline __mmask8 LaneMask(size_t remaining)
+{
+	return remaining >= 8 ? static_cast<__mmask8>(0xFF) : static_cast<__mmask8>((1u << remaining) - 1);
+}
+// ----------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+static bool DominatesAVX512(const double *l, const double *r, size_t M)
+{
+	__mmask8 better = 0;
+	for (size_t f=0; f<M; f+=8)
+	{
+		__mmask8 lanes = LaneMask(M-f);
+		__m512d a = _mm512_maskz_loadu_pd(lanes, l+f), b = _mm512_maskz_loadu_pd(lanes, r+f);
+		if (_mm512_mask_cmp_pd_mask(lanes, a, b, _CMP_GT_OQ)) return false;
+		better |= _mm512_mask_cmp_pd_mask(lanes, a, b, _CMP_LT_OQ);
+	}
+
+	return better != 0;
+}
+// ----------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+static bool AnyDominatesAVX512(const double *matrix, const size_t *rows, size_t n, const double *r, size_t M)
+{
+	if (M > 16)
+	{
+		for (size_t j=n; j>0; j-=1)
+		{
+			if (DominatesAVX512(matrix + rows[j-1]*M, r, M)) return true;
+		}
+		return false;
+	}
+
+	// up to 16 objectives: keep r in two registers for the whole block
+	const __mmask8 lo = LaneMask(M), hi = M > 8 ? LaneMask(M-8) : static_cast<__mmask8>(0);
+	const __m512d r0 = _mm512_maskz_loadu_pd(lo, r), r1 = _mm512_maskz_loadu_pd(hi, r+8);
+
+	for (size_t j=n; j>0; j-=1)
+	{
+		const double *l = matrix + rows[j-1]*M;
+		__m512d a0 = _mm512_maskz_loadu_pd(lo, l), a1 = _mm512_maskz_loadu_pd(hi, l+8);
+
+		if (_mm512_mask_cmp_pd_mask(lo, a0, r0, _CMP_GT_OQ) | _mm512_mask_cmp_pd_mask(hi, a1, r1, _CMP_GT_OQ)) continue;
+		if (_mm512_mask_cmp_pd_mask(lo, a0, r0, _CMP_LT_OQ) | _mm512_mask_cmp_pd_mask(hi, a1, r1, _CMP_LT_OQ)) return true;
+	}
+	return false;
+}
+#endif // DOMINANCE_X86_SIMD
+
+
+// ----------------------------------------------------------------------------------
+//						Runtime dispatch
+// ----------------------------------------------------------------------------------
+typedef bool (*TDominates)(const double *, const double *, size_t);
+typedef bool (*TAnyDominates)(const double *, const size_t *, size_t, const double *, size_t);
+
+static DominanceKernel current_kernel = dkScalar;
+static TDominates dominates_kernel = DominatesScalar;
+static TAnyDominates any_dominates_kernel = AnyDominatesScalar;
+
+bool SupportsDominanceKernel(DominanceKernel kernel)
+{
+#ifdef DOMINANCE_X86_SIMD
+	__builtin_cpu_init();
+	if (kernel == dkAVX2) return __builtin_cpu_supports("avx2");
+	if (kernel == dkAVX512) return __builtin_cpu_supports("avx512f");
+#endif
+	return kernel == dkScalar;
+}
+// ----------------------------------------------------------------------------------
+bool UseDominanceKernel(DominanceKernel kernel)
+{
+	if (!SupportsDominanceKernel(kernel)) return false;
+
+	current_kernel = kernel;
+	dominates_kernel = DominatesScalar;
+	any_dominates_kernel = AnyDominatesScalar;
+#ifdef DOMINANCE_X86_SIMD
+	if (kernel == dkAVX2)
+	{
+		dominates_kernel = DominatesAVX2;
+		any_dominates_kernel = AnyDominatesAVX2;
+	}
+	else if (kernel == dkAVX512)
+	{
+		dominates_kernel = DominatesAVX512;
+		any_dominates_kernel = AnyDominatesAVX512;
+	}
+#endif
+	return true;
+}
+// ----------------------------------------------------------------------------------
+static bool UseBestDominanceKernel()
+{
+	return UseDominanceKernel(dkAVX512) || UseDominanceKernel(dkAVX2) || UseDominanceKernel(dkScalar);
+}
+static const bool best_kernel_selected = UseBestDominanceKernel();
+// ----------------------------------------------------------------------------------
+DominanceKernel CurrentDominanceKernel() { return current_kernel; }
+// ----------------------------------------------------------------------------------
+const char * DominanceKernelName(DominanceKernel kernel)
+{
+	switch (kernel)
+	{
+	case dkAVX2: return "AVX2";
+	case dkAVX512: return "AVX-512";
+	case dkScalar:
+	default: return "scalar";
+	}
+}
+// ----------------------------------------------------------------------------------
+bool ParetoDominates(const double *l, const double *r, size_t M)
+{
+	return dominates_kernel(l, r, M);
+}
+// ----------------------------------------------------------------------------------
+bool AnyParetoDominates(const double *matrix, const size_t *rows, size_t n, const double *r, size_t M)
+{
+	return any_dominates_kernel(matrix, rows, n, r, M);
+}
 // ----------------------------------------------------------------------------------
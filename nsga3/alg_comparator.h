@@ -1,7 +1,10 @@
 #ifndef COMPARATOR__
 #define COMPARATOR__
 
+#include <cstddef>
+
 class CIndividual;
+class CPopulation;
 
 // ----------------------------------------------------------------------------------
 //			BComparator : the base class of comparison operators
@@ -12,6 +15,10 @@ public:
 	virtual ~BComparator() {}
 
 	virtual bool	operator()(const CIndividual &l, const CIndividual &r) const = 0;
+
+	// Batch form: whether any of pop[members[0..n-1]] is "better" than r.
+	// The members are tested from the last one to the first one.
+	virtual bool	AnyOf(const CPopulation &pop, const std::size_t *members, std::size_t n, const CIndividual &r) const;
 };
 
 
@@ -20,12 +27,32 @@ public:
 //			CParetoDominate
 // ----------------------------------------------------------------------------------
 
-class CParetoDominate : public BComparator 
+class CParetoDominate : public BComparator
 {
 public:
 	virtual	bool	operator()(const CIndividual &l, const CIndividual &r) const;
+	virtual bool	AnyOf(const CPopulation &pop, const std::size_t *members, std::size_t n, const CIndividual &r) const;
 };
 
 
-extern CParetoDominate ParetoDominate;
+// ----------------------------------------------------------------------------------
+//			Pareto dominance kernels
+//
+// ParetoDominates(): l <= r on all M objectives and l < r on at least one.
+// AnyParetoDominates(): whether any of the given rows of a row-major matrix
+// with M columns dominates r (rows are tested from the last to the first).
+//
+// AVX-512 and AVX2 versions are selected at runtime when the CPU supports
+// them; otherwise (or on other architectures) the scalar version is used.
+// ----------------------------------------------------------------------------------
+enum DominanceKernel { dkScalar, dkAVX2, dkAVX512 };
+
+bool ParetoDominates(const double *l, const double *r, std::size_t M);
+bool AnyParetoDominates(const double *matrix, const std::size_t *rows, std::size_t n, const double *r, std::size_t M);
+
+bool SupportsDominanceKernel(DominanceKernel kernel);
+bool UseDominanceKernel(DominanceKernel kernel); // return false if the CPU does not support it
+DominanceKernel CurrentDominanceKernel();
+const char * DominanceKernelName(DominanceKernel kernel);
+
 #endif
@@ -34,28 +34,30 @@ bool CSimulatedBinaryCrossover::operator()(CIndividual *child1,
 										   const CIndividual &parent1, 
 										   const CIndividual &parent2, 
 										   double cr, 
-										   double eta) const
+										   double eta,
+										   const BProblem &prob,
+										   CRandomGenerator *rng) const
 {
-	*child1 = parent1;
-	*child2 = parent2;
+	std::copy(parent1.vars().begin(), parent1.vars().end(), child1->vars().begin());
+	std::copy(parent2.vars().begin(), parent2.vars().end(), child2->vars().begin());
 
-	if (MathAux::random(0.0, 1.0) > cr) return false; // not crossovered
+	if (MathAux::random(rng, 0.0, 1.0) > cr) return false; // not crossovered
 
 	CIndividual::TDecVec &c1 = child1->vars(), &c2 = child2->vars();
 	const CIndividual::TDecVec &p1 = parent1.vars(), &p2 = parent2.vars();						
 
 	for (size_t i=0; i<c1.size(); i+=1)
 	{
-		if (MathAux::random(0.0, 1.0) > 0.5) continue; // these two variables are not crossovered
+		if (MathAux::random(rng, 0.0, 1.0) > 0.5) continue; // these two variables are not crossovered
 		if (std::fabs(p1[i]-p2[i]) <= MathAux::EPS) continue; // two values are the same
 		
 		double y1 = std::min(p1[i], p2[i]),
 			   y2 = std::max(p1[i], p2[i]);
 
-		double lb = CIndividual::TargetProblem().lower_bounds()[i],
-			   ub = CIndividual::TargetProblem().upper_bounds()[i];
+		double lb = prob.lower_bounds()[i],
+			   ub = prob.upper_bounds()[i];
 
-		double rand = MathAux::random(0.0, 1.0);
+		double rand = MathAux::random(rng, 0.0, 1.0);
 
 		// child 1
 		double beta = 1.0 + (2.0*(y1-lb)/(y2-y1)),
@@ -75,7 +77,7 @@ bool CSimulatedBinaryCrossover::operator()(CIndividual *child1,
 		c1[i] = std::min(ub, std::max(lb, c1[i]));
 		c2[i] = std::min(ub, std::max(lb, c2[i]));
 
-		if (MathAux::random(0.0, 1.0) <= 0.5)
+		if (MathAux::random(rng, 0.0, 1.0) <= 0.5)
 		{
 			std::swap(c1[i], c2[i]);
 		}
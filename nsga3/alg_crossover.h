@@ -4,10 +4,15 @@
 
 // ----------------------------------------------------------------------------------
 //		CSimulatedBinaryCrossover : simulated binary crossover (SBX)
+//
+// Only the decision variables of the children are written; their objectives are
+// left for the evaluation that follows.
 // ----------------------------------------------------------------------------------
 
 
 class CIndividual;
+class BProblem;
+class CRandomGenerator;
 class CSimulatedBinaryCrossover
 {
 public:
@@ -18,10 +23,11 @@ public:
 	void SetDistributionIndex(double eta) { eta_ = eta; }
 	double DistributionIndex() const { return eta_; }
 
-	bool operator()(CIndividual *c1, CIndividual *c2, const CIndividual &p1, const CIndividual &p2, double cr, double eta) const;
-	bool operator()(CIndividual *c1, CIndividual *c2, const CIndividual &p1, const CIndividual &p2) const
+	// prob: the bounds of the decision variables
+	bool operator()(CIndividual *c1, CIndividual *c2, const CIndividual &p1, const CIndividual &p2, double cr, double eta, const BProblem &prob, CRandomGenerator *rng) const;
+	bool operator()(CIndividual *c1, CIndividual *c2, const CIndividual &p1, const CIndividual &p2, const BProblem &prob, CRandomGenerator *rng) const
 	{
-		return operator()(c1, c2, p1, p2, cr_, eta_);
+		return operator()(c1, c2, p1, p2, cr_, eta_, prob, rng);
 	}
 
 private:
@@ -0,0 +1,64 @@
+#include "alg_elite_archive.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// ----------------------------------------------------------------------
+CEliteArchive::CEliteArchive(size_t num_rps, size_t num_vars, size_t num_objs):
+	occupied_(num_rps, 0),
+	slot_(num_rps, 0),
+	pool_(0, num_vars, num_objs)
+{
+}
+// ----------------------------------------------------------------------
+void CEliteArchive::Store(size_t r, const CIndividual &indv, double length, double distance)
+{
+	if (!occupied_[r])
+	{
+		occupied_[r] = 1;
+		slot_[r] = pool_.size();
+		pool_.resize(pool_.size()+1);
+		length_.push_back(0);
+		distance_.push_back(0);
+	}
+
+	pool_[ slot_[r] ] = indv; // copies the values into the row
+	length_[ slot_[r] ] = length;
+	distance_[ slot_[r] ] = distance;
+}
+// ----------------------------------------------------------------------
+void CEliteArchive::Swap(size_t r, CIndividual *indv, double length, double distance)
+{
+	CIndividual &elite = pool_[ slot_[r] ];
+	std::swap_ranges(elite.vars().begin(), elite.vars().end(), indv->vars().begin());
+	std::swap_ranges(elite.objs().begin(), elite.objs().end(), indv->objs().begin());
+	std::swap_ranges(elite.conv_objs().begin(), elite.conv_objs().end(), indv->conv_objs().begin());
+
+	length_[ slot_[r] ] = length;
+	distance_[ slot_[r] ] = distance;
+}
+// ----------------------------------------------------------------------
+void CEliteArchive::clear()
+{
+	occupied_.assign(occupied_.size(), 0);
+	pool_.clear();
+	length_.clear();
+	distance_.clear();
+}
+// ----------------------------------------------------------------------
+void CEliteArchive::Export(CPopulation *elites, vector<size_t> *rps) const
+{
+	*elites = CPopulation(0, pool_.num_variables(), pool_.num_objectives());
+	elites->reserve(NumOccupied());
+	if (rps) rps->clear();
+
+	for (size_t r=0; r<size(); r+=1)
+	{
+		if (!occupied_[r]) continue;
+
+		elites->push_back(pool_[ slot_[r] ]);
+		if (rps) rps->push_back(r);
+	}
+}
+// ----------------------------------------------------------------------
@@ -0,0 +1,53 @@
+#ifndef ELITE_ARCHIVE__
+#define ELITE_ARCHIVE__
+
+#include "alg_population.h"
+
+#include <vector>
+#include <cstddef>
+
+// ----------------------------------------------------------------------------------
+//		CEliteArchive
+//
+// The improved version keeps the best individual found so far for each reference
+// point (its elite). Whether a reference point has an elite is kept in a bitmap.
+// The elites are rows of a population that only grows when a reference point gets
+// its first elite, so the memory follows the number of occupied reference points;
+// replacing an elite copies the values into its row and never allocates.
+//
+// The length of the objective vector of an elite and its perpendicular distance to
+// the reference point do not change while it is stored, so they are computed once,
+// when it is stored.
+// ----------------------------------------------------------------------------------
+class CEliteArchive
+{
+public:
+	CEliteArchive(std::size_t num_rps, std::size_t num_vars, std::size_t num_objs);
+
+	std::size_t size() const { return occupied_.size(); } // the number of reference points
+	std::size_t NumOccupied() const { return pool_.size(); }
+
+	bool Has(std::size_t r) const { return occupied_[r] != 0; }
+	const CIndividual & operator[](std::size_t r) const { return pool_[ slot_[r] ]; }
+	double Length(std::size_t r) const { return length_[ slot_[r] ]; } // MathAux::length() of the objectives
+	double Distance(std::size_t r) const { return distance_[ slot_[r] ]; } // MathAux::PerpendicularDistance() to the reference point
+
+	// length and distance are the ones of indv (the caller has computed them for comparison)
+	void Store(std::size_t r, const CIndividual &indv, double length, double distance);
+	// exchanges the values of the elite of r and indv (which becomes the elite)
+	void Swap(std::size_t r, CIndividual *indv, double length, double distance);
+
+	void clear(); // no elite (the memory is kept for the next run)
+
+	// the elites in the order of the reference points, and the reference point of each (if rps is given)
+	void Export(CPopulation *elites, std::vector<std::size_t> *rps = 0) const;
+
+private:
+	std::vector<char> occupied_;
+	std::vector<std::size_t> slot_; // slot_[r]: the row of the elite of reference point r (if occupied)
+
+	CPopulation pool_; // the elites, in the order in which the reference points got their first one
+	std::vector<double> length_, distance_; // one per row of pool_
+};
+
+#endif
@@ -3,6 +3,9 @@
 #include "aux_math.h"
 #include "alg_nondominated_sort.h"
 #include "alg_reference_point.h"
+#include "alg_niche_state.h"
+#include "alg_elite_archive.h"
+#include "alg_association.h"
 
 #include <limits>
 #include <algorithm>
@@ -20,10 +23,11 @@ using namespace std;
 //
 // Check steps 1-3 in Algorithm 2 in the original paper of NSGAIII.
 // ----------------------------------------------------------------------
-vector<double> TranslateObjectives(CPopulation *ppop, const CNondominatedSort::TFronts &fronts)
+void TranslateObjectives(vector<double> *pideal_point, CPopulation *ppop, const CNondominatedSort::TFronts &fronts)
 {
 	CPopulation &pop = *ppop;
-	vector<double> ideal_point(pop[0].objs().size());
+	vector<double> &ideal_point = *pideal_point;
+	ideal_point.resize(pop[0].objs().size());
 
 	const size_t NumObj = pop[0].objs().size();
 	for (size_t f=0; f<NumObj; f+=1)
@@ -40,14 +44,11 @@ vector<double> TranslateObjectives(CPopulation *ppop, const CNondominatedSort::T
 			for (size_t i=0; i<fronts[t].size(); i+=1)
 			{
 				size_t ind = fronts[t][i];
-				pop[ind].conv_objs().resize(NumObj);
 				pop[ind].conv_objs()[f] = pop[ind].objs()[f] - minf;
 			}
 		}
 	}
 
-	return ideal_point;
-
 }// TranslateObjectives()
 
 // ----------------------------------------------------------------------
@@ -59,14 +60,15 @@ vector<double> TranslateObjectives(CPopulation *ppop, const CNondominatedSort::T
 //
 // Check step 4 in Algorithm 2 and eq. (4) in the original paper.
 // ----------------------------------------------------------------------
-void FindExtremePoints(vector<size_t> *extreme_points, const CPopulation &pop, const CNondominatedSort::TFronts &fronts)
+void FindExtremePoints(vector<size_t> *extreme_points, const CPopulation &pop, const CNondominatedSort::TFronts &fronts, SSelectionWorkspace *ws)
 {
 	vector<size_t> &exp = *extreme_points;
 	exp.clear();
 
+	vector<double> &w = ws->weights;
 	for (size_t f=0; f<pop[0].objs().size(); f+=1)
 	{
-		vector<double> w(pop[0].objs().size(), 0.000001);
+		w.assign(pop[0].objs().size(), 0.000001);
 		w[f] = 1.0;
 
 		double min_ASF = numeric_limits<double>::max();
@@ -107,11 +109,12 @@ void FindExtremePoints(vector<size_t> *extreme_points, const CPopulation &pop, c
 // implementations and recommending the modification.
 //
 // ----------------------------------------------------------------------
-vector<double> FindMaxObjectives(const CPopulation &pop)
+void FindMaxObjectives(vector<double> *pmax_point, const CPopulation &pop)
 {
 	const size_t NumObj = pop[0].objs().size();
 
-	vector<double> max_point(NumObj, -numeric_limits<double>::max());
+	vector<double> &max_point = *pmax_point;
+	max_point.assign(NumObj, -numeric_limits<double>::max());
 	for (size_t i=0; i<pop.size(); i+=1)
 	{
 		for (size_t f=0; f<NumObj; f+=1)
@@ -119,8 +122,6 @@ vector<double> FindMaxObjectives(const CPopulation &pop)
 			max_point[f] = std::max(max_point[f], pop[i].objs()[f]);
 		}
 	}
-
-	return max_point;
 }
 
 // ----------------------------------------------------------------------
@@ -131,7 +132,7 @@ vector<double> FindMaxObjectives(const CPopulation &pop)
 //
 // Check step 6 in Algorithm 2 in the original paper.
 // ----------------------------------------------------------------------
-void ConstructHyperplane(vector<double> *pintercepts, const CPopulation &pop, const vector<size_t> &extreme_points)
+void ConstructHyperplane(vector<double> *pintercepts, const CPopulation &pop, const vector<size_t> &extreme_points, SSelectionWorkspace *ws)
 {
 	// Check whether there are duplicate extreme points.
 	// This might happen but the original paper does not mention how to deal with it.
@@ -150,15 +151,17 @@ void ConstructHyperplane(vector<double> *pintercepts, const CPopulation &pop, co
 	bool negative_intercept = false;
 	if (!duplicate)
 	{
-		// Find the equation of the hyperplane
-		vector<double> b(pop[0].objs().size(), 1.0);
-		vector< vector<double> > A;
+		// Find the equation of the hyperplane (A x = b with b = 1, augmented)
+		vector< vector<double> > &A = ws->A;
+		A.resize(extreme_points.size());
 		for (size_t p=0; p<extreme_points.size(); p+=1)
 		{
-			A.push_back(pop[ extreme_points[p] ].conv_objs()); // v1.11: objs() -> conv_objs()
+			const CIndividual::TObjVec &conv_objs = pop[ extreme_points[p] ].conv_objs(); // v1.11: objs() -> conv_objs()
+			A[p].assign(conv_objs.begin(), conv_objs.end());
+			A[p].push_back(1.0);
 		}
-		vector<double> x;
-		MathAux::GuassianElimination(&x, A, b);
+		vector<double> &x = ws->x;
+		MathAux::GuassianElimination(&x, &A);
 
 		// Find intercepts
 		for (size_t f=0; f<intercepts.size(); f+=1)
@@ -175,7 +178,8 @@ void ConstructHyperplane(vector<double> *pintercepts, const CPopulation &pop, co
 
 	if (duplicate || negative_intercept) // v1.2: follow the method in Yuan et al. (GECCO 2015)
 	{
-		vector<double> max_objs = FindMaxObjectives(pop);
+		vector<double> &max_objs = ws->max_objs;
+		FindMaxObjectives(&max_objs, pop);
 		for (size_t f=0; f<intercepts.size(); f+=1)
 		{
 			intercepts[f] = max_objs[f];
@@ -216,59 +220,55 @@ void NormalizeObjectives(CPopulation *ppop, const CNondominatedSort::TFronts &fr
 // Find the reference point with the minimal cluster size.
 // Return one randomly if there is more than one point.
 //
+// The reference points are kept in buckets by cluster size (see CNicheState),
+// so this does not scan the reference points.
+//
 // Check steps 3-4 in Algorithm 4 in the original paper.
 // ----------------------------------------------------------------------
-size_t FindNicheReferencePoint(const vector<CReferencePoint> &rps)
+size_t FindNicheReferencePoint(CNicheState *niche_state, CRandomGenerator *rng)
 {
-	// find the minimal cluster size
-	size_t min_size = numeric_limits<size_t>::max();
-	for (size_t r=0; r<rps.size(); r+=1)
-	{
-		min_size = std::min(min_size, rps[r].MemberSize());
-	}
-
-	// find the reference points with the minimal cluster size Jmin
-	vector<size_t> min_rps;
-	for (size_t r=0; r<rps.size(); r+=1)
-	{
-		if (rps[r].MemberSize() == min_size)
-		{
-			min_rps.push_back(r);
-		}
-	}
-
-	// return a random reference point (j-bar)
-	return min_rps[rand()%min_rps.size()];
+	// return a random reference point (j-bar) among the ones with the minimal cluster size Jmin
+	return niche_state->RandomMinNiche(rng);
 }
 
 // ----------------------------------------------------------------------
 // SelectClusterMember():
 //
 // Select a potential member (an individual in the front Fl) and associate
-// it with the reference point.
+// it with the reference point. It is no longer a potential member afterwards.
+// Return -1 if the reference point has no potential member.
 //
 // Check the last two paragraphs in Section IV-E in the original paper.
 // ----------------------------------------------------------------------
-int SelectClusterMember(const CReferencePoint &rp)
+int SelectClusterMember(CNicheState *niche_state, size_t r, CRandomGenerator *rng)
 {
 	int chosen = -1;
-	if (rp.HasPotentialMember())
+	if (niche_state->HasPotentialMember(r))
 	{
-		if (rp.MemberSize() == 0) // currently has no member
+		size_t pos = 0;
+		if (niche_state->MemberSize(r) == 0) // currently has no member
 		{
-			chosen =  rp.FindClosestMember();
+			pos = niche_state->FindClosestMember(r);
 		}
 		else
 		{
-			chosen =  rp.RandomMember();
+			pos = niche_state->RandomMember(r, rng);
+		}
+
+		if (pos < niche_state->PotentialMemberSize(r))
+		{
+			chosen = static_cast<int>(niche_state->PotentialMember(r, pos));
+			niche_state->RemovePotentialMember(r, pos);
 		}
 	}
 	return chosen;
 }
 
-void AppendPopulationMember(CPopulation& next, CIndividual& indv, NSGAIIIAnalysis analysis, size_t t, vector<pair<size_t, double>>& best_objs)
+void AddSurvivor(vector<size_t> *survivors, const CPopulation &cur, size_t i, NSGAIIIAnalysis analysis, size_t t, vector<pair<size_t, double>>& best_objs)
 {
-	next.push_back(indv);
+	survivors->push_back(i);
+
+	const CIndividual &indv = cur[i];
 	if (analysis & NSGAIIIAnalysis::ObjValIterationSetter)
 	{
 		for (size_t i=0; i<indv.objs().size(); i+=1)
@@ -286,57 +286,54 @@ void AppendPopulationMember(CPopulation& next, CIndividual& indv, NSGAIIIAnalysi
 //
 // Check Algorithms 1-4 in the original paper.
 // ----------------------------------------------------------------------
-void EnvironmentalSelection(size_t t, CPopulation *pnext, CPopulation *pcur, vector<CReferencePoint> rps, vector<CIndividual>& elites, size_t PopSize, bool improved_version, NSGAIIIAnalysis analysis, vector<int>& rps_members, vector<size_t>& set_at, vector<pair<size_t, double>>& best_objs)
+void EnvironmentalSelection(size_t t, CPopulation *pnext, CPopulation *pcur, const CNondominatedSort &sort, const CAssociation &associate, CRandomGenerator *rng, CNicheState *pniche_state, SSelectionWorkspace *ws, CEliteArchive& elites, size_t PopSize, bool improved_version, NSGAIIIAnalysis analysis, vector<int>& rps_members, vector<size_t>& set_at, vector<pair<size_t, double>>& best_objs)
 {
 	CPopulation &cur = *pcur, &next = *pnext;
-	next.clear();
+	CNicheState &niches = *pniche_state;
+	const vector<CReferencePoint> &rps = niches.rps();
+	vector<size_t> &survivors = ws->survivors;
+	survivors.clear();
 
-	// ---------- Step 4 in Algorithm 1: non-dominated sorting ----------
-	CNondominatedSort::TFronts fronts = NondominatedSort(cur);
-
-	// ---------- Steps 5-7 in Algorithm 1 ----------
-	vector<size_t> considered; // St
-	size_t last = 0, next_size = 0;
-	while (next_size < PopSize)
-	{
-		next_size += fronts[last].size();
-		last += 1;
-	}
-	fronts.erase(fronts.begin()+last, fronts.end()); // remove useless individuals
+	// ---------- Steps 4-7 in Algorithm 1: non-dominated sorting ----------
+	// Only the fronts up to the one where PopSize is reached are produced (St).
+	CNondominatedSort::TFronts &fronts = ws->fronts;
+	sort(&fronts, cur, PopSize, &ws->sort);
 
 	for (size_t t=0; t<fronts.size()-1; t+=1)
 	{
 		for (size_t i=0; i<fronts[t].size(); i+=1)
 		{
-			AppendPopulationMember(next, cur[ fronts[t][i] ], analysis, t, best_objs);
+			AddSurvivor(&survivors, cur, fronts[t][i], analysis, t, best_objs);
 		}
 	}
 
 	// ---------- Steps 9-10 in Algorithm 1 ----------
-	if (next.size() == PopSize) return;
+	if (survivors.size() == PopSize)
+	{
+		next.Gather(cur, survivors);
+		return;
+	}
 
 	// ---------- Step 14 / Algorithm 2 ----------
-	vector<double> ideal_point = TranslateObjectives(&cur, fronts);
+	vector<double> &ideal_point = ws->ideal_point;
+	TranslateObjectives(&ideal_point, &cur, fronts);
 
-	vector<size_t> extreme_points;
-	FindExtremePoints(&extreme_points, cur, fronts);
+	vector<size_t> &extreme_points = ws->extreme_points;
+	FindExtremePoints(&extreme_points, cur, fronts, ws);
 
-	vector<double> intercepts;
-	ConstructHyperplane(&intercepts, cur, extreme_points);
+	vector<double> &intercepts = ws->intercepts;
+	ConstructHyperplane(&intercepts, cur, extreme_points, ws);
 
 	NormalizeObjectives(&cur, fronts, intercepts, ideal_point);
 
 	// ---------- Step 15 / Algorithm 3, Step 16 ----------
-	Associate(&rps, cur, fronts);
+	niches.Reset();
+	associate(&niches, cur, fronts, &ws->association);
+	niches.BeginNiching();
 
 	// ---------- Step 17 / Algorithm 4 ----------
-	size_t next_rp = 0;
+	size_t next_rp = 0; // improved version: the active reference points are taken in turn
 	
-	vector<size_t> rps_indices;
-	for (size_t i=0; i<rps.size(); i+=1)
-	{
-		rps_indices.push_back(i);
-	}
 	if (analysis & NSGAIIIAnalysis::Entropy)
 	{
 		rps_members.resize(rps.size(), 0);
@@ -344,22 +341,21 @@ void EnvironmentalSelection(size_t t, CPopulation *pnext, CPopulation *pcur, vec
 	
 	size_t elites_used = 0;
 	size_t elites_updated = 0;
-	while (next.size() < PopSize)
+	while (survivors.size() < PopSize)
 	{
 		size_t min_rp = 0;
-		if (fronts.size() == 1 && improved_version && next_rp < rps.size())
+		if (fronts.size() == 1 && improved_version && (next_rp = niches.NextActive(next_rp)) < rps.size())
 		{
 			min_rp = next_rp;
 		} else {
-			min_rp = FindNicheReferencePoint(rps);
+			min_rp = FindNicheReferencePoint(&niches, rng);
 		}
-		auto pt_rp_idx = rps_indices[min_rp];
+		auto pt_rp_idx = min_rp;
 		
-		int chosen = SelectClusterMember(rps[min_rp]);
+		int chosen = SelectClusterMember(&niches, min_rp, rng);
 		if (chosen < 0) // no potential member in Fl, disregard this reference point
 		{
-			rps.erase(rps.begin()+min_rp);
-			rps_indices.erase(rps_indices.begin()+min_rp);
+			niches.Deactivate(min_rp);
 		}
 		else
 		{
@@ -368,52 +364,51 @@ void EnvironmentalSelection(size_t t, CPopulation *pnext, CPopulation *pcur, vec
 				rps_members[pt_rp_idx] = (rps_members[pt_rp_idx] + 1);
 			}
 			
-			auto chosen_member = cur[chosen];
-			auto elite = elites[pt_rp_idx];
-			if (elite.vars()[0] != 0)
+			const CIndividual &chosen_member = cur[chosen];
+			double member_length = MathAux::length(chosen_member.objs());
+			double member_dst = MathAux::PerpendicularDistance(rps[min_rp].pos(), rps[min_rp].squared_norm(), chosen_member.objs());
+			if (elites.Has(pt_rp_idx))
 			{
-				double elite_length = MathAux::length(elite.objs());
-				double member_length = MathAux::length(chosen_member.objs());
-				
-				double elite_dst = MathAux::PerpendicularDistance(rps[min_rp].pos(), elite.objs());
-				double member_dst = MathAux::PerpendicularDistance(rps[min_rp].pos(), chosen_member.objs());
-				
-				bool ignore = rand() % 2;
+				const CIndividual &elite = elites[pt_rp_idx];
+				double elite_length = elites.Length(pt_rp_idx);
+				double elite_dst = elites.Distance(pt_rp_idx);
 				
 				bool new_is_better = ((member_length < elite_length) || (member_dst < elite_dst));
+				
+				// elite preservation natural selection member advantage coeficient
+				float mmb_adv = (MathAux::random_index(rng, 2) == 0) ? 1.1 : 1.3;
+				bool update_elite = (member_length < elite_length * mmb_adv && member_dst < elite_dst * mmb_adv);
+
 				if (new_is_better)
 				{
-					AppendPopulationMember(next, chosen_member, analysis, t, best_objs);
+					if (update_elite) elites.Store(pt_rp_idx, chosen_member, member_length, member_dst);
 					if (analysis & NSGAIIIAnalysis::ElitesUpdateTracking)
 					{
 						set_at[pt_rp_idx] = t;
 					}
 				}
-				else
+				else // the elite survives in the row of the chosen member
 				{
-					AppendPopulationMember(next, elite, analysis, t, best_objs);
+					if (update_elite) elites.Swap(pt_rp_idx, &cur[chosen], member_length, member_dst);
+					else cur[chosen] = elite;
 					elites_used++;
 				}
-				
-				// elite preservation natural selection member advantage coeficient
-				float mmb_adv = (rand() % 2 == 0) ? 1.1 : 1.3;
-				if (member_length < elite_length * mmb_adv && member_dst < elite_dst * mmb_adv)
-				{
-					elites[pt_rp_idx] = chosen_member;
-					elites_updated++;
-				}
+				AddSurvivor(&survivors, cur, chosen, analysis, t, best_objs);
+
+				if (update_elite) elites_updated++;
 			}
 			else
 			{
-				elites[pt_rp_idx] = chosen_member;
-				AppendPopulationMember(next, chosen_member, analysis, t, best_objs);
+				elites.Store(pt_rp_idx, chosen_member, member_length, member_dst);
+				AddSurvivor(&survivors, cur, chosen, analysis, t, best_objs);
 			}
 			
-			rps[min_rp].AddMember();
-			rps[min_rp].RemovePotentialMember(chosen);
+			niches.AddMember(min_rp);
 			next_rp+=1;
 		}
 	}
+
+	next.Gather(cur, survivors);
 	
 	if (analysis & NSGAIIIAnalysis::ElitesUsedAndUpdated)
 	{
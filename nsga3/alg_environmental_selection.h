@@ -2,23 +2,53 @@
 #define ENVIRONMENTAL_SELECTION__
 #include <vector>
 #include "alg_analysis.h"
+#include "alg_nondominated_sort.h"
+#include "alg_association.h"
 
 // ----------------------------------------------------------------------
 //	The environmental selection mechanism is the key innovation of 
 //  the NSGA-III algorithm.
 //
 //  Check Algorithm I in the original paper of NSGA-III.
+//
+//  The survivors are selected as rows of the current population and
+//  gathered into the next one at the end, so each survivor is copied
+//  once. (An elite that survives instead of a chosen member is first
+//  copied into the row of that member, which is not considered again.)
 // ----------------------------------------------------------------------
 
 class CPopulation;
-class CReferencePoint;
-class CIndividual;
+class CNicheState;
+class CEliteArchive;
+class CRandomGenerator;
+
+// ----------------------------------------------------------------------
+// Buffers used by EnvironmentalSelection(). The solver passes the same
+// workspace in every generation, so the selection does not allocate once
+// they have grown to the sizes needed.
+// ----------------------------------------------------------------------
+struct SSelectionWorkspace
+{
+	CNondominatedSort::TFronts fronts;
+	CNondominatedSort::SWorkspace sort;
+	CAssociation::SWorkspace association;
+
+	std::vector<double> ideal_point, intercepts, max_objs, weights, x;
+	std::vector<std::size_t> extreme_points;
+	std::vector< std::vector<double> > A; // the augmented matrix of the hyperplane
+
+	std::vector<std::size_t> survivors; // the rows of the current population that form the next one
+};
 
 void EnvironmentalSelection(size_t t,
 							CPopulation *pnext, // population in the next generation
 							CPopulation *pcur,  // population in the current generation
-							std::vector<CReferencePoint> rps, // the set of reference points,
-							std::vector<CIndividual>& elites,
+							const CNondominatedSort &sort, // the non-dominated sorting engine
+							const CAssociation &associate, // the association engine, built from rps
+							CRandomGenerator *rng, // for breaking ties among reference points and members
+							CNicheState *niche_state, // the niches of the reference points (reset in every call)
+							SSelectionWorkspace *ws,
+							CEliteArchive& elites, // the improved version: the elite of each reference point
 							std::size_t PopSize,
 							bool improved_version,
 							NSGAIIIAnalysis analysis,
@@ -1,26 +1,75 @@
-
 #include "alg_individual.h"
-#include "problem_base.h"
 
-using std::size_t;
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
 
+using std::size_t;
 
-const BProblem * CIndividual::target_problem_ = 0;
 // ----------------------------------------------------------------------
 CIndividual::CIndividual(std::size_t num_vars, std::size_t num_objs):
-	variables_(num_vars), 
-	objectives_(num_objs),
-	converted_objectives_(num_objs)
+	standalone_(true)
+{
+	Allocate(num_vars, num_objs);
+}
+// ----------------------------------------------------------------------
+CIndividual::CIndividual(TGene *vars, std::size_t num_vars, double *objs, double *conv_objs, std::size_t num_objs):
+	standalone_(false),
+	variables_(vars, num_vars),
+	objectives_(objs, num_objs),
+	converted_objectives_(conv_objs, num_objs)
+{
+}
+// ----------------------------------------------------------------------
+CIndividual::CIndividual(const CIndividual &other):
+	standalone_(true)
+{
+	Allocate(other.vars().size(), other.objs().size());
+	*this = other;
+}
+// ----------------------------------------------------------------------
+CIndividual::CIndividual(CIndividual &&other) noexcept:
+	storage_(std::move(other.storage_)), // the block does not move, so the views stay valid
+	standalone_(other.standalone_),
+	variables_(other.variables_),
+	objectives_(other.objectives_),
+	converted_objectives_(other.converted_objectives_)
 {
-	if (target_problem_ != 0)
+	if (other.standalone_)
 	{
-		variables_.resize(target_problem_->num_variables());
-		objectives_.resize(target_problem_->num_objectives());
-		converted_objectives_.resize(target_problem_->num_objectives());
+		other.variables_ = TDecVec();
+		other.objectives_ = other.converted_objectives_ = TObjVec();
 	}
 }
 // ----------------------------------------------------------------------
-const BProblem & CIndividual::TargetProblem() { return *target_problem_; }
+CIndividual & CIndividual::operator=(const CIndividual &other)
+{
+	if (this == &other) return *this;
+
+	if (vars().size() != other.vars().size() || objs().size() != other.objs().size())
+	{
+		Allocate(other.vars().size(), other.objs().size());
+	}
+
+	std::copy(other.vars().begin(), other.vars().end(), variables_.begin());
+	std::copy(other.objs().begin(), other.objs().end(), objectives_.begin());
+	std::copy(other.conv_objs().begin(), other.conv_objs().end(), converted_objectives_.begin());
+
+	return *this;
+}
+// ----------------------------------------------------------------------
+void CIndividual::Allocate(std::size_t num_vars, std::size_t num_objs)
+{
+	// a row of a population cannot be resized: its own storage would detach it from the row
+	if (!standalone_) throw std::logic_error("CIndividual: a row of a population cannot be resized");
+
+	storage_.assign(num_vars + 2*num_objs, 0);
+
+	double *p = storage_.data();
+	variables_ = TDecVec(p, num_vars);
+	objectives_ = TObjVec(p + num_vars, num_objs);
+	converted_objectives_ = TObjVec(p + num_vars + num_objs, num_objs);
+}
 // ----------------------------------------------------------------------
 std::ostream & operator << (std::ostream &os, const CIndividual &indv)
 {
@@ -1,24 +1,39 @@
 #ifndef INDIVIDUAL__
 #define INDIVIDUAL__
 
+#include "aux_array_view.h"
+
 #include <vector>
 #include <ostream>
 
 // ----------------------------------------------------------------------
 //		CIndividual
+//
+// A member of a population is a lightweight view of one row of the
+// population matrices (see CPopulation). A standalone individual (e.g.
+// a copy of a member) owns its data in a single block.
+//
+// Assignment copies the values, so assigning to a population member
+// writes into the population. A member cannot be resized: assigning an
+// individual of other sizes to it throws std::logic_error.
 // ----------------------------------------------------------------------
 
-class BProblem;
-
 class CIndividual
 {
 public:
 	typedef double TGene;
-	typedef std::vector<TGene> TDecVec;
-	typedef std::vector<double> TObjVec;
+	typedef CArrayView<TGene> TDecVec;
+	typedef CArrayView<double> TObjVec;
 
 	explicit CIndividual(std::size_t num_vars = 0, std::size_t num_objs = 0);
 
+	// a view of data owned by someone else (used by CPopulation)
+	CIndividual(TGene *vars, std::size_t num_vars, double *objs, double *conv_objs, std::size_t num_objs);
+
+	CIndividual(const CIndividual &other); // always a standalone copy
+	CIndividual(CIndividual &&other) noexcept;
+	CIndividual & operator=(const CIndividual &other);
+
 	TDecVec & vars() { return variables_; }
 	const TDecVec & vars() const { return variables_; }
 
@@ -28,16 +43,15 @@ public:
 	TObjVec & conv_objs() { return converted_objectives_; }
 	const TObjVec & conv_objs() const { return converted_objectives_; }
 
-	// if a target problem is set, memory will be allocated accordingly in the constructor
-	static void SetTargetProblem(const BProblem &p) { target_problem_ = &p; }
-	static const BProblem & TargetProblem();
-
 private:
+	void Allocate(std::size_t num_vars, std::size_t num_objs);
+
+	std::vector<double> storage_; // [vars, objs, conv_objs] of a standalone individual
+	bool standalone_;
+
 	TDecVec variables_;
 	TObjVec objectives_;
 	TObjVec converted_objectives_;
-
-	static const BProblem *target_problem_;
 };
 
 std::ostream & operator << (std::ostream &os, const CIndividual &indv);
@@ -9,14 +9,13 @@
 class CIndividual;
 class CPopulation;
 class BProblem;
+class CRandomGenerator;
 
 class CRandomInitialization
 {
 public:
-	void operator()(CPopulation *pop, const BProblem &prob) const;
-	void operator()(CIndividual *indv, const BProblem &prob) const;
+	void operator()(CPopulation *pop, const BProblem &prob, CRandomGenerator *rng) const;
+	void operator()(CIndividual *indv, const BProblem &prob, CRandomGenerator *rng) const;
 };
 
-extern CRandomInitialization RandomInitialization;
-
 #endif
@@ -15,7 +15,7 @@ using std::size_t;
 //
 // ref: http://www.slideshare.net/paskorn/simulated-binary-crossover-presentation#
 // ---------------------------------------------------------------------
-bool CPolynomialMutation::operator()(CIndividual *indv, double mr, double eta) const
+bool CPolynomialMutation::operator()(CIndividual *indv, double mr, double eta, const BProblem &prob, CRandomGenerator *rng) const
 {
 	//int j;
 	//double rnd, delta1, delta2, mut_pow, deltaq;
@@ -27,20 +27,20 @@ bool CPolynomialMutation::operator()(CIndividual *indv, double mr, double eta) c
 
 	for (size_t i=0; i<x.size(); i+=1)
 	{
-		if (MathAux::random(0.0, 1.0) <= mr)
+		if (MathAux::random(rng, 0.0, 1.0) <= mr)
 		{
 			mutated = true;
 
 			double y = x[i],
-			lb = CIndividual::TargetProblem().lower_bounds()[i],
-			ub = CIndividual::TargetProblem().upper_bounds()[i];
+			lb = prob.lower_bounds()[i],
+			ub = prob.upper_bounds()[i];
 
 			double delta1 = (y-lb)/(ub-lb),
 			delta2 = (ub-y)/(ub-lb);
 
 			double mut_pow = 1.0/(eta+1.0);
 
-			double rnd = MathAux::random(0.0, 1.0), deltaq = 0.0;
+			double rnd = MathAux::random(rng, 0.0, 1.0), deltaq = 0.0;
 			if (rnd <= 0.5)
 			{
 				double xy = 1.0-delta1;
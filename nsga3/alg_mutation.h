@@ -6,6 +6,8 @@
 // ----------------------------------------------------------------------------------
 
 class CIndividual;
+class BProblem;
+class CRandomGenerator;
 
 class CPolynomialMutation
 {
@@ -17,10 +19,11 @@ public:
 	void SetDistributionIndex(double eta) { eta_ = eta; }
 	double DistributionIndex() const { return eta_; }
 
-	bool operator()(CIndividual *c, double mr, double eta) const;
-	bool operator()(CIndividual *c) const
+	// prob: the bounds of the decision variables
+	bool operator()(CIndividual *c, double mr, double eta, const BProblem &prob, CRandomGenerator *rng) const;
+	bool operator()(CIndividual *c, const BProblem &prob, CRandomGenerator *rng) const
 	{
-		return operator()(c, mr_, eta_);
+		return operator()(c, mr_, eta_, prob, rng);
 	}
 
 private:
@@ -0,0 +1,250 @@
+#include "alg_niche_state.h"
+#include "alg_reference_point.h"
+#include "aux_math.h"
+
+#include <limits>
+using namespace std;
+
+const size_t CNicheState::UnknownClosest = numeric_limits<size_t>::max();
+
+// ----------------------------------------------------------------------
+CNicheState::CNicheState(const vector<CReferencePoint> &rps):
+	rps_(&rps),
+	member_size_(rps.size(), 0),
+	first_potential_(rps.size()+1, 0),
+	num_potential_(rps.size(), 0),
+	closest_(rps.size(), 0),
+	active_(rps.size(), 1),
+	num_active_(rps.size()),
+	niching_(false),
+	order_(rps.size(), 0),
+	order_pos_(rps.size(), 0),
+	min_count_(0)
+{
+}
+// ----------------------------------------------------------------------
+void CNicheState::Reserve(size_t max_size)
+{
+	added_.reserve(max_size);
+	added_rp_.reserve(max_size);
+	potential_members_.reserve(max_size);
+
+	// the count of a reference point never exceeds the number of its members
+	// and potential members (see BeginNiching())
+	bucket_begin_.reserve(max_size+2);
+	active_begin_.reserve(max_size+2);
+}
+// ----------------------------------------------------------------------
+void CNicheState::Reset()
+{
+	for (size_t r=0; r<size(); r+=1)
+	{
+		member_size_[r] = 0;
+		num_potential_[r] = 0;
+		closest_[r] = 0;
+		active_[r] = 1;
+	}
+	added_.clear(); // keeps the capacity
+	added_rp_.clear();
+	num_active_ = size();
+	niching_ = false;
+}
+// ----------------------------------------------------------------------
+void CNicheState::BeginNiching()
+{
+	// the potential members grouped by reference point, each group in the order
+	// in which they were added
+	for (size_t i=0; i<added_rp_.size(); i+=1)
+	{
+		num_potential_[ added_rp_[i] ] += 1;
+	}
+	for (size_t r=0; r<size(); r+=1)
+	{
+		first_potential_[r+1] = first_potential_[r] + num_potential_[r];
+		num_potential_[r] = 0;
+	}
+
+	potential_members_.resize(added_.size());
+	for (size_t i=0; i<added_.size(); i+=1)
+	{
+		size_t r = added_rp_[i], pos = num_potential_[r];
+		potential_members_[ first_potential_[r]+pos ] = added_[i];
+		num_potential_[r] += 1;
+
+		// the first one with the smallest distance (as in a scan of the list)
+		if (added_[i].second < potential_members_[ first_potential_[r]+closest_[r] ].second)
+		{
+			closest_[r] = pos;
+		}
+	}
+
+	// the reference points sorted by member count (counting sort), the deactivated
+	// ones first in each bucket; a count grows by one for each potential member that joins
+	size_t max_count = 0;
+	for (size_t r=0; r<size(); r+=1)
+	{
+		max_count = std::max(max_count, member_size_[r]);
+	}
+	size_t num_buckets = max_count + added_.size() + 1;
+	if (bucket_begin_.size() < num_buckets+1)
+	{
+		bucket_begin_.resize(num_buckets+1);
+		active_begin_.resize(num_buckets+1);
+	}
+
+	CountBuckets(num_buckets);
+	for (size_t c=0; c<num_buckets; c+=1)
+	{
+		active_begin_[c] = bucket_begin_[c];
+	}
+	for (size_t r=0; r<size(); r+=1)
+	{
+		if (active_[r]) continue;
+
+		size_t pos = active_begin_[ member_size_[r] ]++;
+		order_[pos] = r;
+		order_pos_[r] = pos;
+	}
+	for (size_t r=0; r<size(); r+=1)
+	{
+		if (!active_[r]) continue;
+
+		size_t pos = --bucket_begin_[ member_size_[r]+1 ]; // from the end of the bucket
+		order_[pos] = r;
+		order_pos_[r] = pos;
+	}
+	CountBuckets(num_buckets); // the loop above has moved the beginnings
+
+	min_count_ = 0;
+	niching_ = true;
+}
+// ----------------------------------------------------------------------
+void CNicheState::AddMember(size_t r)
+{
+	if (niching_ && active_[r])
+	{
+		MoveToNextBucket(r);
+	}
+	else
+	{
+		member_size_[r] += 1;
+	}
+}
+// ----------------------------------------------------------------------
+void CNicheState::AddPotentialMember(size_t r, size_t member_ind, double distance)
+{
+	added_.push_back(make_pair(member_ind, distance));
+	added_rp_.push_back(r);
+}
+// ----------------------------------------------------------------------
+size_t CNicheState::FindClosestMember(size_t r)
+{
+	if (closest_[r] == UnknownClosest) // the closest one was removed
+	{
+		const pair<size_t, double> *members = &potential_members_[ first_potential_[r] ];
+
+		double min_dist = numeric_limits<double>::max();
+		closest_[r] = num_potential_[r];
+		for (size_t i=0; i<num_potential_[r]; i+=1)
+		{
+			if (members[i].second < min_dist)
+			{
+				min_dist = members[i].second;
+				closest_[r] = i;
+			}
+		}
+	}
+
+	return closest_[r];
+}
+// ----------------------------------------------------------------------
+size_t CNicheState::RandomMember(size_t r, CRandomGenerator *rng) const
+{
+	return MathAux::random_index(rng, num_potential_[r]);
+}
+// ----------------------------------------------------------------------
+void CNicheState::RemovePotentialMember(size_t r, size_t pos)
+{
+	pair<size_t, double> *members = &potential_members_[ first_potential_[r] ];
+
+	size_t last = num_potential_[r]-1;
+	if (closest_[r] == pos)
+	{
+		closest_[r] = UnknownClosest;
+	}
+	else if (closest_[r] == last)
+	{
+		closest_[r] = pos;
+	}
+
+	members[pos] = members[last];
+	num_potential_[r] -= 1;
+}
+// ----------------------------------------------------------------------
+void CNicheState::Deactivate(size_t r)
+{
+	if (active_[r])
+	{
+		if (niching_) // to the deactivated ones at the front of its bucket
+		{
+			size_t c = member_size_[r];
+			SwapOrder(order_pos_[r], active_begin_[c]);
+			active_begin_[c] += 1;
+		}
+		active_[r] = 0;
+		num_active_ -= 1;
+	}
+}
+// ----------------------------------------------------------------------
+size_t CNicheState::NextActive(size_t r) const
+{
+	while (r < size() && !active_[r]) r += 1;
+	return r;
+}
+// ----------------------------------------------------------------------
+size_t CNicheState::RandomMinNiche(CRandomGenerator *rng)
+{
+	while (active_begin_[min_count_] == bucket_begin_[min_count_+1]) min_count_ += 1;
+
+	size_t first = active_begin_[min_count_];
+	return order_[ first + MathAux::random_index(rng, bucket_begin_[min_count_+1]-first) ];
+}
+// ----------------------------------------------------------------------
+void CNicheState::CountBuckets(size_t num_buckets)
+{
+	for (size_t c=0; c<=num_buckets; c+=1)
+	{
+		bucket_begin_[c] = 0;
+	}
+	for (size_t r=0; r<size(); r+=1)
+	{
+		bucket_begin_[ member_size_[r]+1 ] += 1;
+	}
+	for (size_t c=1; c<=num_buckets; c+=1)
+	{
+		bucket_begin_[c] += bucket_begin_[c-1];
+	}
+}
+// ----------------------------------------------------------------------
+void CNicheState::SwapOrder(size_t i, size_t j)
+{
+	std::swap(order_[i], order_[j]);
+	order_pos_[ order_[i] ] = i;
+	order_pos_[ order_[j] ] = j;
+}
+// ----------------------------------------------------------------------
+void CNicheState::MoveToNextBucket(size_t r)
+{
+	size_t c = member_size_[r];
+
+	// the last one of bucket c (active, as r is) becomes the first one of bucket c+1 ...
+	SwapOrder(order_pos_[r], bucket_begin_[c+1]-1);
+	bucket_begin_[c+1] -= 1;
+
+	// ... and is moved behind the deactivated ones of bucket c+1
+	active_begin_[c+1] -= 1;
+	SwapOrder(bucket_begin_[c+1], active_begin_[c+1]);
+
+	member_size_[r] = c+1;
+}
+// ----------------------------------------------------------------------
@@ -0,0 +1,102 @@
+#ifndef NICHE_STATE__
+#define NICHE_STATE__
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+class CReferencePoint;
+class CRandomGenerator;
+
+// ----------------------------------------------------------------------------------
+//		CNicheState
+//
+// The niche of each reference point in one environmental selection: the number of
+// members (individuals in St/Fl associated with it, rho_j in the paper), the potential
+// members in the last front Fl, and whether it is still considered in the niching
+// (Algorithm 4 disregards a reference point once it has no potential member left).
+//
+// It is created once per run by the solver. The reference points themselves are never
+// copied or modified; Reset() clears the niches in place at the start of each
+// selection, so the buffers are only allocated in the first generations.
+//
+// During the niching (after BeginNiching()) the active reference points are also kept
+// in buckets by member count, so finding a random reference point with the fewest
+// members, adding a member and deactivating a reference point are all O(1) (amortized
+// for the first one, since the minimal count never decreases).
+//
+// The potential members of a reference point are addressed by their position in its
+// list. The closest one is tracked when they are added, and a chosen member is removed
+// by moving the last one into its place, so both are O(1).
+//
+// The buckets and the lists are ranges of flat arrays (one entry per reference point and
+// per potential member) that BeginNiching() lays out by counting, so their capacity only
+// depends on the population size. Reserve() allocates it up front and no generation
+// allocates afterwards.
+// ----------------------------------------------------------------------------------
+class CNicheState
+{
+public:
+	explicit CNicheState(const std::vector<CReferencePoint> &rps);
+
+	const std::vector<CReferencePoint> & rps() const { return *rps_; }
+	std::size_t size() const { return member_size_.size(); }
+
+	// room for a population of max_size individuals (members and potential members)
+	void Reserve(std::size_t max_size);
+
+	void Reset(); // no members and all the reference points active
+	void BeginNiching(); // after the association: lay out the lists and the buckets
+
+	// ---------- Algorithm 3: association ----------
+	void AddMember(std::size_t r);
+	void AddPotentialMember(std::size_t r, std::size_t member_ind, double distance);
+
+	// ---------- Algorithm 4: niching (after BeginNiching()) ----------
+	std::size_t MemberSize(std::size_t r) const { return member_size_[r]; }
+	bool HasPotentialMember(std::size_t r) const { return num_potential_[r] != 0; }
+	std::size_t PotentialMemberSize(std::size_t r) const { return num_potential_[r]; }
+	std::size_t PotentialMember(std::size_t r, std::size_t pos) const { return potential_members_[ first_potential_[r]+pos ].first; }
+	std::size_t FindClosestMember(std::size_t r); // a position (PotentialMemberSize(r) if none)
+	std::size_t RandomMember(std::size_t r, CRandomGenerator *rng) const; // a position (there must be one)
+	void RemovePotentialMember(std::size_t r, std::size_t pos);
+
+	bool IsActive(std::size_t r) const { return active_[r] != 0; }
+	std::size_t NumActive() const { return num_active_; }
+	void Deactivate(std::size_t r); // disregard the reference point in this selection
+	std::size_t NextActive(std::size_t r) const; // the first active one from r on (size() if none)
+
+	// a random active reference point with the fewest members (there must be one)
+	std::size_t RandomMinNiche(CRandomGenerator *rng);
+
+private:
+	const std::vector<CReferencePoint> *rps_;
+
+	std::vector<std::size_t> member_size_;
+
+	// pair<indices of individuals in the population, distance>
+	// note. only the data of individuals in the last considered front
+	// will be stored.
+	std::vector< std::pair<std::size_t, double> > added_; // in the order of AddPotentialMember()
+	std::vector<std::size_t> added_rp_; // the reference point of each one in added_
+	std::vector< std::pair<std::size_t, double> > potential_members_; // by reference point (after BeginNiching())
+	std::vector<std::size_t> first_potential_, num_potential_; // the range of each reference point
+	std::vector<std::size_t> closest_; // the position of the closest potential member (UnknownClosest: to be found)
+	static const std::size_t UnknownClosest;
+
+	std::vector<char> active_;
+	std::size_t num_active_;
+
+	void CountBuckets(std::size_t num_buckets); // bucket_begin_ from the member counts
+	void SwapOrder(std::size_t i, std::size_t j); // swaps two positions in order_
+	void MoveToNextBucket(std::size_t r); // one more member
+
+	// The reference points sorted by member count: bucket c is [bucket_begin_[c], bucket_begin_[c+1])
+	// in order_, with its deactivated reference points first (before active_begin_[c]).
+	bool niching_; // whether the buckets are in use
+	std::vector<std::size_t> order_, order_pos_; // order_pos_[r]: the position of r in order_
+	std::vector<std::size_t> bucket_begin_, active_begin_;
+	std::size_t min_count_; // no active reference point has fewer members
+};
+
+#endif
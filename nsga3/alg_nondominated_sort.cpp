@@ -2,21 +2,124 @@
 #include "alg_nondominated_sort.h"
 #include "alg_population.h"
 
+#include <algorithm>
+
 using namespace std;
 
-CNondominatedSort NondominatedSort(ParetoDominate);
 // ----------------------------------------------------------------------
 
 std::vector< CNondominatedSort::TFrontMembers > CNondominatedSort::operator()(const CPopulation &pop) const
 {
-	CNondominatedSort::TFronts fronts;
+	return operator()(pop, pop.size());
+}
+// ----------------------------------------------------------------------
+std::vector< CNondominatedSort::TFrontMembers > CNondominatedSort::operator()(const CPopulation &pop, std::size_t max_ranked) const
+{
+	TFronts fronts;
+	SWorkspace ws;
+	operator()(&fronts, pop, max_ranked, &ws);
+	return fronts;
+}
+// ----------------------------------------------------------------------
+// ReleaseFronts():
+//
+// Empty the fronts, keeping the members' buffers in the workspace.
+// ----------------------------------------------------------------------
+static void ReleaseFronts(CNondominatedSort::TFronts *fronts, CNondominatedSort::SWorkspace *ws)
+{
+	while (!fronts->empty())
+	{
+		fronts->back().clear();
+		ws->spare_fronts.push_back(std::move(fronts->back()));
+		fronts->pop_back();
+	}
+}
+// ----------------------------------------------------------------------
+// OpenFront():
+//
+// Append an empty front, reusing a buffer from the workspace if any.
+// ----------------------------------------------------------------------
+static void OpenFront(CNondominatedSort::TFronts *fronts, CNondominatedSort::SWorkspace *ws)
+{
+	if (ws->spare_fronts.empty())
+	{
+		fronts->push_back(CNondominatedSort::TFrontMembers());
+	}
+	else
+	{
+		fronts->push_back(std::move(ws->spare_fronts.back()));
+		ws->spare_fronts.pop_back();
+	}
+}
+// ----------------------------------------------------------------------
+void CNondominatedSort::operator()(TFronts *fronts, const CPopulation &pop, size_t max_ranked, SWorkspace *ws) const
+{
+	ReleaseFronts(fronts, ws);
+
+	switch (engine_)
+	{
+	case nsNaive:
+		SortNaive(fronts, pop, max_ranked, ws);
+		break;
+	case nsENS_SS:
+		SortENS(fronts, pop, max_ranked, false, ws);
+		break;
+	case nsJensen:
+		if (pop.size() > 0 && pop[0].objs().size() == 2) SortJensen2D(fronts, pop, max_ranked, ws);
+		else SortENS(fronts, pop, max_ranked, true, ws);
+		break;
+	case nsENS_BS:
+	default:
+		SortENS(fronts, pop, max_ranked, true, ws);
+		break;
+	}
+
+}// CNondominatedSort::operator()
+// ----------------------------------------------------------------------
+const char * CNondominatedSort::EngineName(EEngine engine)
+{
+	switch (engine)
+	{
+	case nsNaive: return "Naive";
+	case nsENS_SS: return "ENS-SS";
+	case nsENS_BS: return "ENS-BS";
+	case nsJensen: return "Jensen";
+	default: return "";
+	}
+}
+// ----------------------------------------------------------------------
+bool CNondominatedSort::ParseEngine(const std::string &name, EEngine *engine)
+{
+	const EEngine engines[] = { nsNaive, nsENS_SS, nsENS_BS, nsJensen };
+	for (size_t i=0; i<sizeof(engines)/sizeof(engines[0]); i+=1)
+	{
+		if (name == EngineName(engines[i]))
+		{
+			*engine = engines[i];
+			return true;
+		}
+	}
+	return false;
+}
+// ----------------------------------------------------------------------
+// SortNaive():
+//
+// Peel off one front at a time by scanning all the unranked individuals.
+// This is the original implementation of nsga3cpp.
+// ----------------------------------------------------------------------
+void CNondominatedSort::SortNaive(TFronts *pfronts, const CPopulation &pop, size_t max_ranked, SWorkspace *ws) const
+{
+	CNondominatedSort::TFronts &fronts = *pfronts;
 	size_t num_assigned_individuals = 0;
 	size_t rank = 1;
-	vector<size_t> indv_ranks(pop.size(), 0);
+	vector<size_t> &indv_ranks = ws->ranks;
+	indv_ranks.assign(pop.size(), 0);
 
-	while (num_assigned_individuals < pop.size())
+	max_ranked = std::min(max_ranked, pop.size());
+	while (num_assigned_individuals < max_ranked)
 	{
-		CNondominatedSort::TFrontMembers cur_front;
+		OpenFront(&fronts, ws);
+		CNondominatedSort::TFrontMembers &cur_front = fronts.back();
 
 		for (size_t i=0; i<pop.size(); i+=1)
 		{
@@ -46,13 +149,159 @@ std::vector< CNondominatedSort::TFrontMembers > CNondominatedSort::operator()(co
 		{
 			indv_ranks[ cur_front[i] ] = rank;
 		}
-		fronts.push_back(cur_front);
 		num_assigned_individuals += cur_front.size();
-		
+
 		rank += 1;
 	}
 
-	return fronts;
+}// CNondominatedSort::SortNaive()
+// ----------------------------------------------------------------------
+// LexicographicOrder():
+//
+// Sort the indices of individuals by their objective vectors (f1 first,
+// then f2, ...). An individual can never be dominated by one that comes
+// after it in this order.
+// ----------------------------------------------------------------------
+static void LexicographicOrder(vector<size_t> *porder, const CPopulation &pop)
+{
+	vector<size_t> &order = *porder;
+	order.resize(pop.size());
+	for (size_t i=0; i<order.size(); i+=1)
+	{
+		order[i] = i;
+	}
 
-}// CNondominatedSort::operator()
+	sort(order.begin(), order.end(), [&pop](size_t l, size_t r)
+	{
+		const CIndividual::TObjVec &lo = pop[l].objs(), &ro = pop[r].objs();
+		for (size_t f=0; f<lo.size(); f+=1)
+		{
+			if (lo[f] < ro[f]) return true;
+			if (lo[f] > ro[f]) return false;
+		}
+		return l < r;
+	});
+}
+// ----------------------------------------------------------------------
+// SortFrontMembers():
+//
+// Put the members of every front in ascending index order, which is the
+// order produced by the naive engine.
+// ----------------------------------------------------------------------
+static void SortFrontMembers(CNondominatedSort::TFronts *fronts)
+{
+	for (size_t t=0; t<fronts->size(); t+=1)
+	{
+		sort((*fronts)[t].begin(), (*fronts)[t].end());
+	}
+}
+// ----------------------------------------------------------------------
+// AddToFront():
+//
+// Used by the engines that visit individuals in lexicographic order.
+// Put individual p into front k (k == fronts->size() opens a new front),
+// then drop the trailing fronts that are no longer needed to rank
+// max_ranked individuals. Since fronts only grow in this order, a dropped
+// front can never become necessary again. *num_ranked is the number of
+// individuals in the kept fronts.
+// ----------------------------------------------------------------------
+static void AddToFront(CNondominatedSort::TFronts *pfronts, size_t *num_ranked, size_t k, size_t p, size_t max_ranked,
+					   CNondominatedSort::SWorkspace *ws)
+{
+	CNondominatedSort::TFronts &fronts = *pfronts;
+
+	if (k == fronts.size())
+	{
+		if (*num_ranked >= max_ranked) return; // p is beyond the last needed front
+		OpenFront(&fronts, ws);
+	}
+	fronts[k].push_back(p);
+	*num_ranked += 1;
+
+	while (fronts.size() > 1 && *num_ranked - fronts.back().size() >= max_ranked)
+	{
+		*num_ranked -= fronts.back().size();
+		fronts.back().clear();
+		ws->spare_fronts.push_back(std::move(fronts.back()));
+		fronts.pop_back();
+	}
+}
+// ----------------------------------------------------------------------
+// SortENS():
+//
+// Visit individuals in lexicographic order and put each one into the
+// first front that contains no individual dominating it. Since a front
+// dominating the individual implies that all the preceding fronts do as
+// well, the front can be found either sequentially or by binary search.
+// ----------------------------------------------------------------------
+void CNondominatedSort::SortENS(TFronts *pfronts, const CPopulation &pop, size_t max_ranked, bool binary_search, SWorkspace *ws) const
+{
+	TFronts &fronts = *pfronts;
+	size_t num_ranked = 0;
+	vector<size_t> &order = ws->order;
+	LexicographicOrder(&order, pop);
+
+	// members added recently are the most similar ones, so check them first
+	auto dominated_by_front = [&](const TFrontMembers &front, size_t p)
+	{
+		return dominate.AnyOf(pop, front.data(), front.size(), pop[p]);
+	};
+
+	for (size_t s=0; s<order.size(); s+=1)
+	{
+		size_t p = order[s], k = 0;
+		if (binary_search)
+		{
+			size_t lo = 0, hi = fronts.size();
+			while (lo < hi)
+			{
+				size_t mid = (lo+hi)/2;
+				if (dominated_by_front(fronts[mid], p)) lo = mid+1;
+				else hi = mid;
+			}
+			k = lo;
+		}
+		else
+		{
+			while (k < fronts.size() && dominated_by_front(fronts[k], p)) k += 1;
+		}
+
+		AddToFront(&fronts, &num_ranked, k, p, max_ranked, ws);
+	}
+
+	SortFrontMembers(&fronts);
+
+}// CNondominatedSort::SortENS()
+// ----------------------------------------------------------------------
+// SortJensen2D():
+//
+// With two objectives and the lexicographic order, the last member of a
+// front has the smallest f2 of the front. An individual is dominated by
+// the front if and only if it is dominated by that member, so a binary
+// search with one comparison per step gives O(N log N).
+// ----------------------------------------------------------------------
+void CNondominatedSort::SortJensen2D(TFronts *pfronts, const CPopulation &pop, size_t max_ranked, SWorkspace *ws) const
+{
+	TFronts &fronts = *pfronts;
+	size_t num_ranked = 0;
+	vector<size_t> &order = ws->order;
+	LexicographicOrder(&order, pop);
+
+	for (size_t s=0; s<order.size(); s+=1)
+	{
+		size_t p = order[s];
+		size_t lo = 0, hi = fronts.size();
+		while (lo < hi)
+		{
+			size_t mid = (lo+hi)/2;
+			if ( dominate(pop[ fronts[mid].back() ], pop[p]) ) lo = mid+1;
+			else hi = mid;
+		}
+
+		AddToFront(&fronts, &num_ranked, lo, p, max_ranked, ws);
+	}
+
+	SortFrontMembers(&fronts);
+
+}// CNondominatedSort::SortJensen2D()
 // ----------------------------------------------------------------------
@@ -2,28 +2,77 @@
 #define NONDOMINATED_SORT__
 
 #include <vector>
+#include <string>
 
 class BComparator;
 class CPopulation;
 
+// ----------------------------------------------------------------------------------
+//		CNondominatedSort
+//
+// All engines return the same fronts (members of each front in ascending index order),
+// so they can be swapped freely. The engines other than nsNaive rely on a lexicographic
+// presort, i.e. they assume the comparator is Pareto dominance on minimized objectives.
+//
+// ENS: Zhang, Tian, Cheng and Jin, "An Efficient Approach to Nondominated Sorting for
+// Evolutionary Multiobjective Optimization," IEEE Transactions on Evolutionary
+// Computation, vol. 19, no. 2, pp. 201-213, 2015.
+//
+// Jensen: Jensen, "Reducing the Run-time Complexity of Multiobjective EAs: The NSGA-II
+// and Other Algorithms," IEEE Transactions on Evolutionary Computation, vol. 7, no. 5,
+// pp. 503-515, 2003. Only the two-objective sweep (the base case of the divide-and-conquer)
+// is implemented; for more objectives it falls back to ENS-BS.
+// ----------------------------------------------------------------------------------
 class CNondominatedSort
 {
 public:
-	explicit CNondominatedSort(const BComparator &d):dominate(d) {}
+	enum EEngine
+	{
+		nsNaive,	// repeated front peeling, O(F*N^2)
+		nsENS_SS,	// efficient non-dominated sort, sequential search
+		nsENS_BS,	// efficient non-dominated sort, binary search
+		nsJensen	// O(N log N) sweep for two objectives
+	};
+
+	explicit CNondominatedSort(const BComparator &d, EEngine engine = nsENS_BS):dominate(d), engine_(engine) {}
 
 	// prohibit copying (VS2012 does not support 'delete')
 	CNondominatedSort(const CNondominatedSort &);
-	CNondominatedSort & operator= (const CNondominatedSort &); 
+	CNondominatedSort & operator= (const CNondominatedSort &);
 
 	typedef std::vector<std::size_t> TFrontMembers; // a set of indices of individuals in a certain front
 	typedef std::vector<TFrontMembers> TFronts; // a set of fronts
 
+	// Buffers reused by the sorts. Sorting into the same fronts with the same
+	// workspace does not allocate once they have grown to the sizes needed.
+	struct SWorkspace
+	{
+		TFronts spare_fronts; // emptied fronts, kept for their capacity
+		std::vector<std::size_t> order, ranks;
+	};
+
+	void SetEngine(EEngine engine) { engine_ = engine; }
+	EEngine Engine() const { return engine_; }
+
 	TFronts operator()(const CPopulation &pop) const;
 
+	// Partial ranking: stop once the fronts found so far hold at least max_ranked
+	// individuals. The last returned front is complete; individuals in the later
+	// fronts are not returned (and mostly never compared at all).
+	TFronts operator()(const CPopulation &pop, std::size_t max_ranked) const;
+	void operator()(TFronts *fronts, const CPopulation &pop, std::size_t max_ranked, SWorkspace *ws) const;
+
+	// engine names used in experiment files (e.g. "ENS-BS")
+	static const char * EngineName(EEngine engine);
+	static bool ParseEngine(const std::string &name, EEngine *engine);
+
 private:
+	void SortNaive(TFronts *fronts, const CPopulation &pop, std::size_t max_ranked, SWorkspace *ws) const;
+	void SortENS(TFronts *fronts, const CPopulation &pop, std::size_t max_ranked, bool binary_search, SWorkspace *ws) const;
+	void SortJensen2D(TFronts *fronts, const CPopulation &pop, std::size_t max_ranked, SWorkspace *ws) const;
+
 	const BComparator &dominate;
+	EEngine engine_;
 };
 
-extern CNondominatedSort NondominatedSort;
-
 #endif
@@ -2,13 +2,20 @@
 #include "problem_base.h"
 #include "alg_individual.h"
 #include "alg_reference_point.h"
+#include "alg_niche_state.h"
+#include "alg_elite_archive.h"
 #include "alg_population.h"
+#include "alg_solver_context.h"
+#include "alg_snapshot_sink.h"
 
 #include "alg_initialization.h"
 #include "alg_crossover.h"
 #include "alg_mutation.h"
 #include "alg_environmental_selection.h"
+#include "alg_comparator.h"
 #include "alg_analysis.h"
+#include "aux_math.h"
+#include "aux_random.h"
 
 #include "gnuplot_interface.h"
 #include "log.h"
@@ -16,6 +23,9 @@
 #include <vector>
 #include <fstream>
 #include <cmath>
+#include <iostream>
+#include <cstdlib>
+#include <cstdint>
 
 using namespace std;
 
@@ -24,12 +34,17 @@ CNSGAIII::CNSGAIII():
 	gen_num_(1),
 	pc_(1.0), // default setting in NSGA-III (IEEE tEC 2014)
 	eta_c_(30), // default setting
-	eta_m_(20) // default setting
+	eta_m_(20), // default setting
+	sort_engine_(CNondominatedSort::nsENS_BS),
+	association_engine_(CAssociation::asDense),
+	num_threads_(1),
+	snapshot_interval_(0),
+	snapshot_variables_(false)
 {
 }
 
 // ----------------------------------------------------------------------
-void CNSGAIII::Setup(ifstream &ifile)
+void CNSGAIII::Setup(istream &ifile)
 {
 	if (!ifile) return;
 
@@ -48,12 +63,46 @@ void CNSGAIII::Setup(ifstream &ifile)
 	ifile >> dummy >> dummy >> pc_;
 	ifile >> dummy >> dummy >> eta_c_;
 	ifile >> dummy >> dummy >> eta_m_;
+
+	// optional settings (e.g. nondominated.sort = ENS-BS, association.engine = BallTree,
+	// thread.number = 4, snapshot.interval = 10, snapshot.variables = 1) until the problem is specified
+	string key;
+	streampos pos = ifile.tellg();
+	while (ifile >> key && key.compare(0, 8, "problem.") != 0)
+	{
+		string value;
+		ifile >> dummy >> value;
+		if (key == "nondominated.sort" && !CNondominatedSort::ParseEngine(value, &sort_engine_))
+		{
+			cout << "Unknown non-dominated sorting engine: " << value << endl;
+		}
+		else if (key == "association.engine" && !CAssociation::ParseEngine(value, &association_engine_))
+		{
+			cout << "Unknown association engine: " << value << endl;
+		}
+		else if (key == "thread.number")
+		{
+			num_threads_ = strtoul(value.c_str(), 0, 10);
+		}
+		else if (key == "snapshot.interval")
+		{
+			snapshot_interval_ = strtoul(value.c_str(), 0, 10);
+		}
+		else if (key == "snapshot.variables")
+		{
+			snapshot_variables_ = (value == "1" || value == "true");
+		}
+		pos = ifile.tellg();
+	}
+	ifile.clear();
+	ifile.seekg(pos);
 }
 // ----------------------------------------------------------------------
-void CNSGAIII::Solve(CPopulation *solutions, const BProblem &problem, bool improved_version)
+void CNSGAIII::Solve(CPopulation *solutions, const BProblem &problem, bool improved_version, uint64_t seed,
+					 CPopulation *elite_archive, BSnapshotSink *snapshots) const
 {
 	auto analysis = NSGAIIIAnalysis::None;
-	CIndividual::SetTargetProblem(problem);
+	CSolverContext ctx(seed, num_threads_);
 	
 	vector<CReferencePoint> rps;
 	GenerateReferencePoints(&rps, problem.num_objectives(), obj_division_p_); 
@@ -61,47 +110,68 @@ void CNSGAIII::Solve(CPopulation *solutions, const BProblem &problem, bool impro
 	while (PopSize%4) PopSize += 1;
 
 	CPopulation pop[2]={
-		CPopulation(PopSize),
-		CPopulation(PopSize)
+		CPopulation(PopSize, problem.num_variables(), problem.num_objectives()),
+		CPopulation(PopSize, problem.num_variables(), problem.num_objectives())
 	};
+	// Each buffer holds the parents and the offspring (2N rows) in turn. With the
+	// capacity reserved once, the generations reuse the rows and never reallocate.
+	pop[0].reserve(2*PopSize);
+	pop[1].reserve(2*PopSize);
 	CSimulatedBinaryCrossover SBX(pc_, eta_c_);
 	CPolynomialMutation PolyMut(1.0/problem.num_variables(), eta_m_);
+	CRandomInitialization initialize;
+	CNondominatedSort sort(ctx.dominate(), sort_engine_);
+	CAssociation associate(rps, association_engine_);
+	CNicheState niches(rps);
+	niches.Reserve(2*PopSize);
+
+	// the offspring of a pair only depend on the random stream of its worker (see CSolverContext)
+	CRandomGenerator &rng = ctx.rng();
+	CThreadPool &pool = ctx.pool();
+	vector<size_t> parents(PopSize);
 
 //	Gnuplot gplot;
 
 	int cur = 0, next = 1;
-	RandomInitialization(&pop[cur], problem);
-	for (size_t i=0; i<PopSize; i+=1)
+	initialize(&pop[cur], problem, &rng);
+	pool.ParallelFor(PopSize, [&](size_t begin, size_t end, size_t)
 	{
-		problem.Evaluate(&pop[cur][i]);
-	}
+		problem.EvaluateBatch(&pop[cur], begin, end);
+	});
+	if (snapshots && snapshots->Wants(0)) snapshots->Push(0, pop[cur]);
 	
 	size_t first_it_max_entropy = -1;
 	size_t it_from_which_max_entropy = -1;
 	const double max_entropy = log(rps.size());
-	vector<CIndividual> elites(rps.size());
+	CEliteArchive elites(rps.size(), problem.num_variables(), problem.num_objectives());
 	vector<size_t> set_at(rps.size(), -1);
 	std::vector<std::pair<size_t, double>> best_objs(pop[cur][0].objs().size(), make_pair(-1, numeric_limits<double>::max()));
 	for (size_t t=0; t<gen_num_; t+=1)
 	{
 		pop[cur].resize(PopSize*2);
 
-		for (size_t i=0; i<PopSize; i+=2)
+		for (size_t i=0; i<PopSize; i+=1)
 		{
-			int father = rand()%PopSize,
-				mother = rand()%PopSize;
+			parents[i] = MathAux::random_index(&rng, PopSize); // father and mother of each pair of children
+		}
 
-			SBX(&pop[cur][PopSize+i], &pop[cur][PopSize+i+1], pop[cur][father], pop[cur][mother]);
+		// the children (rows PopSize, ..., 2*PopSize-1) are only written by the worker of their pair
+		pool.ParallelFor(PopSize/2, [&](size_t begin, size_t end, size_t worker)
+		{
+			for (size_t i=2*begin; i<2*end; i+=2)
+			{
+				CRandomGenerator &worker_rng = ctx.rng(worker);
+				SBX(&pop[cur][PopSize+i], &pop[cur][PopSize+i+1], pop[cur][parents[i]], pop[cur][parents[i+1]], problem, &worker_rng);
 
-			PolyMut(&pop[cur][PopSize+i]);
-			PolyMut(&pop[cur][PopSize+i+1]);
+				PolyMut(&pop[cur][PopSize+i], problem, &worker_rng);
+				PolyMut(&pop[cur][PopSize+i+1], problem, &worker_rng);
+			}
 
-			problem.Evaluate(&pop[cur][PopSize+i]);
-			problem.Evaluate(&pop[cur][PopSize+i+1]);
-		}
+			problem.EvaluateBatch(&pop[cur], PopSize+2*begin, PopSize+2*end);
+		});
 
 		std::vector<int> rps_members;
-		EnvironmentalSelection(t, &pop[next], &pop[cur], rps, elites, PopSize, improved_version, analysis, rps_members, set_at, best_objs);
+		EnvironmentalSelection(t, &pop[next], &pop[cur], sort, associate, &rng, &niches, &ctx.selection_workspace(), elites, PopSize, improved_version, analysis, rps_members, set_at, best_objs);
 
 		if (analysis & NSGAIIIAnalysis::Entropy)
 		{
@@ -133,6 +203,7 @@ void CNSGAIII::Solve(CPopulation *solutions, const BProblem &problem, bool impro
 			cout << entropy << endl;
 		}
 		//ShowPopulation(gplot, pop[next], "pop"); Sleep(50);
+		if (snapshots && snapshots->Wants(t+1)) snapshots->Push(t+1, pop[next]);
 
 		std::swap(cur, next);
 	}
@@ -162,4 +233,5 @@ void CNSGAIII::Solve(CPopulation *solutions, const BProblem &problem, bool impro
 	}
 
 	*solutions = pop[cur];
+	if (elite_archive) elites.Export(elite_archive);
 }
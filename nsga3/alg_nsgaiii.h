@@ -2,9 +2,12 @@
 #define NSGAIII__
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
-#include <fstream>
+#include <istream>
 #include <vector>
+#include "alg_nondominated_sort.h"
+#include "alg_association.h"
 
 // ----------------------------------------------------------------------------------
 //		NSGAIII
@@ -18,15 +21,24 @@
 
 class BProblem;
 class CPopulation;
+class BSnapshotSink;
 
 class CNSGAIII
 {
 public:
 	CNSGAIII();
-	void Setup(std::ifstream &ifile);
-	void Solve(CPopulation *solutions, const BProblem &prob, bool improved_version);
+	void Setup(std::istream &ifile);
+	// elite_archive (optional): the final elites of the improved version, in the order of the reference points
+	// snapshots (optional): receives the population of the generations it wants (0: the initial one)
+	// (const: independent runs may share a solver)
+	void Solve(CPopulation *solutions, const BProblem &prob, bool improved_version, std::uint64_t seed,
+			   CPopulation *elite_archive = 0, BSnapshotSink *snapshots = 0) const;
 
 	const std::string & name() const { return name_; }
+
+	// snapshot.interval and snapshot.variables in the experiment file (see CSnapshotStream)
+	std::size_t snapshot_interval() const { return snapshot_interval_; } // 0: no snapshots
+	bool snapshot_variables() const { return snapshot_variables_; }
 private:
 	std::string name_;
 	std::vector<std::size_t> obj_division_p_;
@@ -35,6 +47,11 @@ private:
 			pm_, // mutation rate
 			eta_c_, // eta in SBX
 			eta_m_; // eta in Polynomial Mutation
+	CNondominatedSort::EEngine sort_engine_;
+	CAssociation::EEngine association_engine_;
+	std::size_t num_threads_; // for offspring generation and evaluation (0: one per hardware thread)
+	std::size_t snapshot_interval_;
+	bool snapshot_variables_;
 };
 
 
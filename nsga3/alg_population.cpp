@@ -0,0 +1,113 @@
+#include "alg_population.h"
+
+#include <algorithm>
+
+using std::size_t;
+
+// ----------------------------------------------------------------------
+CPopulation::CPopulation():
+	num_vars_(0),
+	num_objs_(0)
+{
+}
+// ----------------------------------------------------------------------
+CPopulation::CPopulation(std::size_t s, std::size_t num_vars, std::size_t num_objs):
+	num_vars_(num_vars),
+	num_objs_(num_objs)
+{
+	resize(s);
+}
+// ----------------------------------------------------------------------
+CPopulation::CPopulation(const CPopulation &other):
+	num_vars_(other.num_vars_),
+	num_objs_(other.num_objs_),
+	variables_(other.variables_),
+	objectives_(other.objectives_),
+	converted_objectives_(other.converted_objectives_)
+{
+	Bind(0, other.size());
+}
+// ----------------------------------------------------------------------
+CPopulation & CPopulation::operator=(const CPopulation &other)
+{
+	if (this == &other) return *this;
+
+	num_vars_ = other.num_vars_;
+	num_objs_ = other.num_objs_;
+	variables_ = other.variables_;
+	objectives_ = other.objectives_;
+	converted_objectives_ = other.converted_objectives_;
+	Bind(0, other.size());
+
+	return *this;
+}
+// ----------------------------------------------------------------------
+void CPopulation::resize(size_t t)
+{
+	const double *x = variables_.data(), *f = objectives_.data(), *cf = converted_objectives_.data();
+
+	variables_.resize(t*num_vars_);
+	objectives_.resize(t*num_objs_);
+	converted_objectives_.resize(t*num_objs_);
+
+	bool moved = (x != variables_.data() || f != objectives_.data() || cf != converted_objectives_.data());
+	Bind(moved ? 0 : std::min(size(), t), t);
+}
+// ----------------------------------------------------------------------
+void CPopulation::reserve(size_t t)
+{
+	const double *x = variables_.data(), *f = objectives_.data(), *cf = converted_objectives_.data();
+
+	variables_.reserve(t*num_vars_);
+	objectives_.reserve(t*num_objs_);
+	converted_objectives_.reserve(t*num_objs_);
+	individuals_.reserve(t);
+
+	bool moved = (x != variables_.data() || f != objectives_.data() || cf != converted_objectives_.data());
+	if (moved) Bind(0, size());
+}
+// ----------------------------------------------------------------------
+void CPopulation::push_back(const CIndividual &indv)
+{
+	if (size() == 0 && num_vars_ == 0 && num_objs_ == 0) // take the sizes of the first individual
+	{
+		num_vars_ = indv.vars().size();
+		num_objs_ = indv.objs().size();
+	}
+
+	resize(size()+1);
+	individuals_.back() = indv;
+}
+// ----------------------------------------------------------------------
+void CPopulation::Gather(const CPopulation &src, const std::vector<size_t> &rows)
+{
+	if (num_vars_ != src.num_vars_ || num_objs_ != src.num_objs_) // the views of the rows do not fit
+	{
+		clear();
+		num_vars_ = src.num_vars_;
+		num_objs_ = src.num_objs_;
+	}
+	resize(rows.size());
+
+	for (size_t i=0; i<rows.size(); i+=1)
+	{
+		size_t r = rows[i];
+		std::copy_n(src.variables_.data() + r*num_vars_, num_vars_, variables_.data() + i*num_vars_);
+		std::copy_n(src.objectives_.data() + r*num_objs_, num_objs_, objectives_.data() + i*num_objs_);
+		std::copy_n(src.converted_objectives_.data() + r*num_objs_, num_objs_, converted_objectives_.data() + i*num_objs_);
+	}
+}
+// ----------------------------------------------------------------------
+void CPopulation::Bind(std::size_t first, std::size_t t)
+{
+	individuals_.erase(individuals_.begin()+std::min(first, individuals_.size()), individuals_.end());
+	individuals_.reserve(t);
+
+	for (size_t i=individuals_.size(); i<t; i+=1)
+	{
+		individuals_.emplace_back(variables_.data() + i*num_vars_, num_vars_,
+								  objectives_.data() + i*num_objs_,
+								  converted_objectives_.data() + i*num_objs_, num_objs_);
+	}
+}
+// ----------------------------------------------------------------------
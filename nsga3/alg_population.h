@@ -5,20 +5,57 @@
 
 #include <vector>
 
+// ----------------------------------------------------------------------
+//		CPopulation
+//
+// The decision variables, objectives and converted objectives of all the
+// individuals are stored in three contiguous row-major matrices (row i
+// belongs to individual i). The individuals are views of their rows.
+//
+// Resizing may move the matrices, which invalidates references to the
+// individuals obtained before.
+//
+// Gather() builds a population from selected rows of another one in a
+// single pass over the matrices (e.g. the survivors of a generation).
+// ----------------------------------------------------------------------
 class CPopulation
 {
 public:
-	explicit CPopulation(std::size_t s = 0):individuals_(s) {}
+	CPopulation(); // the sizes of individuals follow the first one added
+	CPopulation(std::size_t s, std::size_t num_vars, std::size_t num_objs);
+	CPopulation(const CPopulation &other);
+	CPopulation & operator=(const CPopulation &other);
 
 	CIndividual & operator[](std::size_t i) { return individuals_[i]; }
 	const CIndividual & operator[](std::size_t i) const { return individuals_[i]; }
 
 	std::size_t size() const { return individuals_.size(); }
-	void resize(size_t t) { individuals_.resize(t); }
-	void push_back(const CIndividual &indv) { individuals_.push_back(indv); }
-	void clear() { individuals_.clear(); }
+	void resize(size_t t);
+	void reserve(size_t t);
+	void push_back(const CIndividual &indv);
+	void clear() { resize(0); }
+
+	// the rows of src in the order given by rows (src must be another population)
+	void Gather(const CPopulation &src, const std::vector<std::size_t> &rows);
+
+	std::size_t num_variables() const { return num_vars_; }
+	std::size_t num_objectives() const { return num_objs_; }
+
+	// the row-major matrices (size() rows)
+	double * vars_data() { return variables_.data(); }
+	const double * vars_data() const { return variables_.data(); }
+	double * objs_data() { return objectives_.data(); }
+	const double * objs_data() const { return objectives_.data(); }
+	double * conv_objs_data() { return converted_objectives_.data(); }
+	const double * conv_objs_data() const { return converted_objectives_.data(); }
 
 private:
+	void Bind(std::size_t first, std::size_t t); // (re)create the views of rows [first, t)
+
+	std::size_t num_vars_, num_objs_;
+	std::vector<double> variables_,
+						objectives_,
+						converted_objectives_;
 	std::vector<CIndividual> individuals_;
 };
 
@@ -1,65 +1,28 @@
 #include "alg_reference_point.h"
+#include "alg_niche_state.h"
 #include "alg_population.h"
 #include "aux_math.h"
 
 #include <limits>
+#include <cmath>
 using namespace std;
 
 
 
-void CReferencePoint::clear()
+CReferencePoint::CReferencePoint(const vector<double> &position):
+	position_(position),
+	unit_direction_(position.size()),
+	squared_norm_(0)
 {
-	member_size_ = 0;
-	potential_members_.clear();
-}
-// ----------------------------------------------------------------------
-void CReferencePoint::AddMember()
-{
-	member_size_ += 1;
-}
-// ----------------------------------------------------------------------
-void CReferencePoint::AddPotentialMember(std::size_t member_ind, double distance)
-{
-	potential_members_.push_back(make_pair(member_ind, distance));
-}
-// ----------------------------------------------------------------------
-int CReferencePoint::FindClosestMember() const
-{
-	double min_dist = numeric_limits<double>::max();
-	int min_indv = -1;
-	for (size_t i=0; i<potential_members_.size(); i+=1)
+	for (size_t i=0; i<position_.size(); i+=1)
 	{
-		if (potential_members_[i].second < min_dist)
-		{
-			min_dist = potential_members_[i].second;
-			min_indv = potential_members_[i].first;
-		}
+		squared_norm_ += MathAux::square(position_[i]);
 	}
 
-	return min_indv;
-}
-// ----------------------------------------------------------------------
-int CReferencePoint::RandomMember() const
-{
-	if (potential_members_.size() > 0)
-	{
-		return potential_members_[rand()%potential_members_.size()].first;
-	}
-	else
-	{
-		return -1;
-	}
-}
-// ----------------------------------------------------------------------
-void CReferencePoint::RemovePotentialMember(std::size_t member_ind)
-{
-	for (size_t i=0; i<potential_members_.size(); i+=1)
+	double norm = sqrt(squared_norm_);
+	for (size_t i=0; i<position_.size(); i+=1)
 	{
-		if (potential_members_[i].first == member_ind)
-		{
-			potential_members_.erase(potential_members_.begin()+i);
-			return;
-		}
+		unit_direction_[i] = position_[i]/norm;
 	}
 }
 
@@ -67,19 +30,19 @@ void CReferencePoint::RemovePotentialMember(std::size_t member_ind)
 // ----------------------------------------------------------------------
 // Other utility functions
 // ----------------------------------------------------------------------
-void generate_recursive(vector<CReferencePoint> *rps, CReferencePoint *pt, size_t num_objs, 
+void generate_recursive(vector<CReferencePoint> *rps, vector<double> *pt, size_t num_objs, 
 						size_t left, size_t total, size_t element)
 {
 	if (element == num_objs-1)
 	{
-		pt->pos()[element] = static_cast<double>(left)/total;
-		rps->push_back(*pt);
+		(*pt)[element] = static_cast<double>(left)/total;
+		rps->push_back(CReferencePoint(*pt));
 	}
 	else
 	{
 		for (size_t i=0; i<=left; i+=1)
 		{
-			pt->pos()[element] = static_cast<double>(i)/total;
+			(*pt)[element] = static_cast<double>(i)/total;
 			generate_recursive(rps, pt, num_objs, left-i, total, element+1);
 		}
 	}
@@ -87,7 +50,7 @@ void generate_recursive(vector<CReferencePoint> *rps, CReferencePoint *pt, size_
 // ----------------------------------------------------------------------
 void GenerateReferencePoints(vector<CReferencePoint> *rps, size_t M, const std::vector<std::size_t> &p)
 {
-	CReferencePoint pt(M);
+	vector<double> pt(M);
 
 	generate_recursive(rps, &pt, M, p[0], p[0], 0);
 
@@ -100,19 +63,20 @@ void GenerateReferencePoints(vector<CReferencePoint> *rps, size_t M, const std::
 
 		for (size_t i=0; i<inside_rps.size(); i+=1)
 		{
-			for (size_t j=0; j<inside_rps[i].pos().size(); j+=1)
+			vector<double> inside = inside_rps[i].pos();
+			for (size_t j=0; j<inside.size(); j+=1)
 			{
-				inside_rps[i].pos()[j] = (center+inside_rps[i].pos()[j])/2; // (k=num_divisions/M, k, k, ..., k) is the center point
+				inside[j] = (center+inside[j])/2; // (k=num_divisions/M, k, k, ..., k) is the center point
 			}
-			rps->push_back(inside_rps[i]);
+			rps->push_back(CReferencePoint(inside));
 		}
 	}
 }
 
 // ----------------------------------------------------------------------
-void Associate(std::vector<CReferencePoint> *prps, const CPopulation &pop, const CNondominatedSort::TFronts &fronts)
+void Associate(CNicheState *niche_state, const CPopulation &pop, const CNondominatedSort::TFronts &fronts)
 {
-	std::vector<CReferencePoint> &rps = *prps;
+	const std::vector<CReferencePoint> &rps = niche_state->rps();
 
 	for (size_t t=0; t<fronts.size(); t+=1)
 	{
@@ -122,8 +86,7 @@ void Associate(std::vector<CReferencePoint> *prps, const CPopulation &pop, const
 			double min_dist = numeric_limits<double>::max();
 			for (size_t r=0; r<rps.size(); r+=1)
 			{
-				const vector<double> &direction = rps[r].pos();
-				double d = MathAux::PerpendicularDistance(direction, pop[ fronts[t][i] ].conv_objs());
+				double d = MathAux::PerpendicularDistance(rps[r].pos(), rps[r].squared_norm(), pop[ fronts[t][i] ].conv_objs());
 				
 				if (d < min_dist)
 				{
@@ -134,11 +97,11 @@ void Associate(std::vector<CReferencePoint> *prps, const CPopulation &pop, const
 
 			if (t+1 != fronts.size()) // associating members in St/Fl (only counting)
 			{
-				rps[min_rp].AddMember();
+				niche_state->AddMember(min_rp);
 			}
 			else
 			{
-				rps[min_rp].AddPotentialMember(fronts[t][i], min_dist);
+				niche_state->AddPotentialMember(min_rp, fronts[t][i], min_dist);
 			}
 
 		}// for - members in front
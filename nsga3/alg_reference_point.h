@@ -2,7 +2,6 @@
 #define REFERENCE_POINT__
 
 #include <vector>
-#include <utility>
 #include "alg_nondominated_sort.h"
 
 // ----------------------------------------------------------------------------------
@@ -13,33 +12,28 @@
 // are determined based on the niche count of the reference points.
 //
 // Check Algorithms 1-4 in the orignal paper for the usage of reference points.
+//
+// A reference point only holds its geometry. The members associated with it in an
+// environmental selection are kept in CNicheState (alg_niche_state.h).
 // ----------------------------------------------------------------------------------
 
 class CReferencePoint
 {
 public:
-	explicit CReferencePoint(std::size_t s):position_(s), member_size_(0) {}
+	explicit CReferencePoint(std::size_t s):position_(s), unit_direction_(s), squared_norm_(0) {}
+	explicit CReferencePoint(const std::vector<double> &position);
 
 	const std::vector<double> & pos() const { return position_; }
-	std::vector<double> & pos() { return position_; }
 
-	std::size_t MemberSize() const { return member_size_; }
-	bool HasPotentialMember() const { return !potential_members_.empty(); }
-	void clear();
-	void AddMember();
-	void AddPotentialMember(std::size_t member_ind, double distance);
-	int FindClosestMember() const;
-	int RandomMember() const;
-	void RemovePotentialMember(std::size_t member_ind);
+	// Cached when the point is created (reference points never move during a run).
+	// squared_norm() is the denominator of MathAux::PerpendicularDistance().
+	const std::vector<double> & unit_direction() const { return unit_direction_; }
+	double squared_norm() const { return squared_norm_; }
 
 private:
-	std::vector<double> position_;
-
-	// pair<indices of individuals in the population, distance>
-	// note. only the data of individuals in the last considered front
-	// will be stored.
-	std::vector< std::pair<std::size_t, double> > potential_members_; 
-	std::size_t member_size_; 
+	std::vector<double> position_,
+						unit_direction_;
+	double squared_norm_;
 };
 
 // ----------------------------------------------------------------------------------
@@ -52,10 +46,11 @@ void GenerateReferencePoints(std::vector<CReferencePoint> *rps, std::size_t M, c
 // ----------------------------------------------------------------------------------
 // Associate():
 //
-// Associate individuals in the population with reference points.
-// Check Algorithm 3 in the original paper.
+// Associate individuals in the population with reference points (the niches of
+// niche_state->rps()). Check Algorithm 3 in the original paper.
 class CPopulation;
-void Associate(std::vector<CReferencePoint> *prps, const CPopulation &pop, const CNondominatedSort::TFronts &fronts);
+class CNicheState;
+void Associate(CNicheState *niche_state, const CPopulation &pop, const CNondominatedSort::TFronts &fronts);
 // ----------------------------------------------------------------------------------
 
 #endif
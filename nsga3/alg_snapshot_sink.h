@@ -0,0 +1,24 @@
+#ifndef SNAPSHOT_SINK__
+#define SNAPSHOT_SINK__
+
+#include <cstddef>
+
+class CPopulation;
+
+// ----------------------------------------------------------------------------------
+//		BSnapshotSink
+//
+// Receives the populations of the generations it wants while CNSGAIII::Solve() runs
+// (e.g. CSnapshotStream, which logs them to a file). Push() is called on the thread of
+// Solve() and must copy what it keeps, since the population is reused afterwards.
+// ----------------------------------------------------------------------------------
+class BSnapshotSink
+{
+public:
+	virtual ~BSnapshotSink() {}
+
+	virtual bool Wants(std::size_t generation) const = 0; // 0: the initial population
+	virtual void Push(std::size_t generation, const CPopulation &pop) = 0;
+};
+
+#endif
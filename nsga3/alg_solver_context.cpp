@@ -0,0 +1,17 @@
+#include "alg_solver_context.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------
+CSolverContext::CSolverContext(uint64_t seed, size_t num_threads):
+	rng_(seed),
+	pool_(num_threads),
+	worker_rngs_(pool_.size(), rng_)
+{
+	for (size_t w=0; w<worker_rngs_.size(); w+=1)
+	{
+		if (w > 0) worker_rngs_[w] = worker_rngs_[w-1];
+		worker_rngs_[w].Jump();
+	}
+}
+// ----------------------------------------------------------------------
@@ -0,0 +1,52 @@
+#ifndef SOLVER_CONTEXT__
+#define SOLVER_CONTEXT__
+
+#include "alg_comparator.h"
+#include "alg_environmental_selection.h"
+#include "aux_random.h"
+#include "aux_thread_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ----------------------------------------------------------------------------------
+//		CSolverContext
+//
+// The state of one call of CNSGAIII::Solve(): the dominance relation, the random
+// streams, the workers and the buffers reused in every generation. None of it is
+// global or static, and the operators get the problem (for its bounds) as an argument,
+// so calls of Solve() on different threads share no state, even when they solve
+// different problems.
+//
+// The calling thread draws from rng(). Worker w of pool() draws from rng(w), a stream
+// jumped ahead from the one before it, so a run only depends on the seed and the
+// number of threads.
+// ----------------------------------------------------------------------------------
+class CSolverContext
+{
+public:
+	CSolverContext(std::uint64_t seed, std::size_t num_threads); // 0 threads: one per hardware thread
+
+	const BComparator & dominate() const { return dominate_; }
+
+	CRandomGenerator & rng() { return rng_; }
+	CRandomGenerator & rng(std::size_t worker) { return worker_rngs_[worker]; }
+	CThreadPool & pool() { return pool_; }
+
+	SSelectionWorkspace & selection_workspace() { return selection_ws_; }
+
+private:
+	CSolverContext(const CSolverContext &);
+	CSolverContext & operator=(const CSolverContext &);
+
+	CParetoDominate dominate_;
+
+	CRandomGenerator rng_;
+	CThreadPool pool_;
+	std::vector<CRandomGenerator> worker_rngs_;
+
+	SSelectionWorkspace selection_ws_;
+};
+
+#endif
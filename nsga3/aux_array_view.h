@@ -0,0 +1,51 @@
+#ifndef ARRAY_VIEW__
+#define ARRAY_VIEW__
+
+#include <cstddef>
+#include <vector>
+
+// ----------------------------------------------------------------------
+//		CArrayView: a non-owning view of a contiguous array
+//
+// The decision and objective vectors of an individual are views of rows
+// of the population matrices (see CPopulation). Constness propagates:
+// a const view only gives const access to the elements.
+// ----------------------------------------------------------------------
+template <typename T>
+class CArrayView
+{
+public:
+	typedef T value_type;
+	typedef T * iterator;
+	typedef const T * const_iterator;
+
+	CArrayView():data_(0), size_(0) {}
+	CArrayView(T *data, std::size_t size):data_(data), size_(size) {}
+
+	template <typename U, typename A>
+	CArrayView(std::vector<U, A> &v):data_(v.data()), size_(v.size()) {}
+	template <typename U, typename A>
+	CArrayView(const std::vector<U, A> &v):data_(v.data()), size_(v.size()) {} // only for views of const T
+	template <typename U>
+	CArrayView(const CArrayView<U> &v):data_(v.data()), size_(v.size()) {} // only for views of const T
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	T * data() { return data_; }
+	const T * data() const { return data_; }
+
+	T & operator[](std::size_t i) { return data_[i]; }
+	const T & operator[](std::size_t i) const { return data_[i]; }
+
+	iterator begin() { return data_; }
+	iterator end() { return data_+size_; }
+	const_iterator begin() const { return data_; }
+	const_iterator end() const { return data_+size_; }
+
+private:
+	T *data_;
+	std::size_t size_;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "aux_async_writer.h"
+
+#include <utility>
+
+// ----------------------------------------------------------------------
+CAsyncWriter::CAsyncWriter():
+	busy_(false),
+	stop_(false),
+	thread_(&CAsyncWriter::WriterLoop, this)
+{
+}
+// ----------------------------------------------------------------------
+CAsyncWriter::~CAsyncWriter()
+{
+	Flush();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	posted_.notify_one();
+	thread_.join();
+}
+// ----------------------------------------------------------------------
+void CAsyncWriter::Post(TTask task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		tasks_.push_back(std::move(task));
+	}
+	posted_.notify_one();
+}
+// ----------------------------------------------------------------------
+void CAsyncWriter::Flush()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+}
+// ----------------------------------------------------------------------
+void CAsyncWriter::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true)
+	{
+		posted_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+		if (tasks_.empty()) return; // stopped
+
+		TTask task = std::move(tasks_.front());
+		tasks_.pop_front();
+		busy_ = true;
+
+		lock.unlock();
+		task();
+		task = TTask(); // release what the task holds before it counts as done
+		lock.lock();
+
+		busy_ = false;
+		if (tasks_.empty()) done_.notify_all();
+	}
+}
+// ----------------------------------------------------------------------
@@ -0,0 +1,44 @@
+#ifndef ASYNC_WRITER_AUX__
+#define ASYNC_WRITER_AUX__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ----------------------------------------------------------------------
+//		CAsyncWriter
+//
+// Runs output tasks (e.g. saving a result file) on a background thread,
+// in the order in which they were posted, so the threads that post them
+// do not wait for the disk. A task must own or share what it writes.
+//
+// Flush() returns when all the tasks posted so far are done; the
+// destructor flushes too. Post() may be called from any thread.
+// ----------------------------------------------------------------------
+class CAsyncWriter
+{
+public:
+	typedef std::function<void ()> TTask;
+
+	CAsyncWriter();
+	~CAsyncWriter();
+
+	void Post(TTask task);
+	void Flush();
+
+private:
+	CAsyncWriter(const CAsyncWriter &);
+	CAsyncWriter & operator=(const CAsyncWriter &);
+
+	void WriterLoop();
+
+	std::mutex mutex_;
+	std::condition_variable posted_, done_;
+	std::deque<TTask> tasks_;
+	bool busy_, stop_;
+	std::thread thread_; // started last, after the members it uses
+};
+
+#endif
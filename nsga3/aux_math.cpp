@@ -10,7 +10,7 @@ namespace MathAux
 // ----------------------------------------------------------------------
 // ASF: Achivement Scalarization Function
 // ----------------------------------------------------------------------
-double ASF(const vector<double> &objs, const vector<double> &weight)
+double ASF(CArrayView<const double> objs, const vector<double> &weight)
 {
 	double max_ratio = -numeric_limits<double>::max();
 	for (size_t f=0; f<objs.size(); f+=1)
@@ -54,14 +54,19 @@ double ASF(const vector<double> &objs, const vector<double> &weight)
 // ---------------------------------------------------------------------
 void GuassianElimination(vector<double> *px, vector< vector<double> > A, const vector<double> &b)
 {
-	vector<double> &x = *px;
-
-	const size_t N = A.size();
-	for (size_t i=0; i<N; i+=1)
+	for (size_t i=0; i<A.size(); i+=1)
 	{
 		A[i].push_back(b[i]);
 	}
+	GuassianElimination(px, &A);
+}
+// ---------------------------------------------------------------------
+void GuassianElimination(vector<double> *px, vector< vector<double> > *augmented)
+{
+	vector<double> &x = *px;
+	vector< vector<double> > &A = *augmented;
 
+	const size_t N = A.size();
 	for (size_t base=0; base<N-1; base+=1)
 	{
 		for (size_t target=base+1; target<N; target+=1)
@@ -104,15 +109,24 @@ void GuassianElimination(vector<double> *px, vector< vector<double> > A, const v
 //    vector<double> dir{1, 3}, point{5.5, 1.5};
 //    cout << PerpendicularDistance(dir, point) << endl;
 // ---------------------------------------------------------------------
-double PerpendicularDistance(const vector<double> &direction, const vector<double> &point)
+double PerpendicularDistance(CArrayView<const double> direction, CArrayView<const double> point)
 {
-	double numerator = 0, denominator = 0;
+	double denominator = 0;
 	for (size_t i=0; i<direction.size(); i+=1)
 	{
-		numerator += direction[i]*point[i];
 		denominator += square(direction[i]);
 	}
-	double k = numerator/denominator;
+	return PerpendicularDistance(direction, denominator, point);
+}
+// ---------------------------------------------------------------------
+double PerpendicularDistance(CArrayView<const double> direction, double squared_norm, CArrayView<const double> point)
+{
+	double numerator = 0;
+	for (size_t i=0; i<direction.size(); i+=1)
+	{
+		numerator += direction[i]*point[i];
+	}
+	double k = numerator/squared_norm;
 
 	double d = 0;
 	for (size_t i=0; i<direction.size(); i+=1)
@@ -123,7 +137,41 @@ double PerpendicularDistance(const vector<double> &direction, const vector<doubl
 }
 // ---------------------------------------------------------------------
 
-double length(const vector<double> &vector)
+void DotProducts(const double *points, size_t n, const double *directions, size_t R, size_t M, double *out)
+{
+	size_t i = 0;
+	for (; i+4<=n; i+=4)
+	{
+		const double *p0 = points+i*M, *p1 = p0+M, *p2 = p1+M, *p3 = p2+M;
+		for (size_t r=0; r<R; r+=1)
+		{
+			const double *d = directions+r*M;
+			double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			for (size_t m=0; m<M; m+=1)
+			{
+				s0 += p0[m]*d[m];
+				s1 += p1[m]*d[m];
+				s2 += p2[m]*d[m];
+				s3 += p3[m]*d[m];
+			}
+			out[i*R+r] = s0;
+			out[(i+1)*R+r] = s1;
+			out[(i+2)*R+r] = s2;
+			out[(i+3)*R+r] = s3;
+		}
+	}
+	for (; i<n; i+=1)
+	{
+		for (size_t r=0; r<R; r+=1)
+		{
+			double s = 0;
+			for (size_t m=0; m<M; m+=1) s += points[i*M+m]*directions[r*M+m];
+			out[i*R+r] = s;
+		}
+	}
+}
+// ---------------------------------------------------------------------
+double length(CArrayView<const double> vector)
 {
 	double sqrSum = 0.0;
 	for (size_t i=0; i<vector.size(); i+=1)
@@ -133,7 +181,7 @@ double length(const vector<double> &vector)
 	return sqrt(sqrSum);
 }
 	
-double dotProduct(const vector<double> &v1, const vector<double> &v2)
+double dotProduct(CArrayView<const double> v1, CArrayView<const double> v2)
 {
 	double mulSum = 0.0;
 	size_t vSize = v1.size();
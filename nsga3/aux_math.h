@@ -2,26 +2,37 @@
 #ifndef MATH_AUX__
 #define MATH_AUX__
 
-#include <cstdlib>
+#include <cstddef>
 #include <vector>
+#include "aux_array_view.h"
+#include "aux_random.h"
 
 namespace MathAux
 {
 const double PI = 3.1415926;
 const double EPS = 1.0e-14; // follow nsga-ii source code
 inline double square(double n) { return n*n; }
-inline double random(double lb, double ub) { return lb + (static_cast<double>(std::rand())/RAND_MAX)*(ub - lb); }
+inline double random(CRandomGenerator *rng, double lb, double ub) { return lb + rng->Uniform()*(ub - lb); }
+inline std::size_t random_index(CRandomGenerator *rng, std::size_t n) { return static_cast<std::size_t>(rng->Uniform()*n); } // [0, n)
 
 // ASF(): achievement scalarization function
-double ASF(const std::vector<double> &objs, const std::vector<double> &weight);
+double ASF(CArrayView<const double> objs, const std::vector<double> &weight);
 
 // GuassianElimination(): used to calculate the hyperplane
 void GuassianElimination(std::vector<double> *px, std::vector< std::vector<double> > A, const std::vector<double> &b);
+// the same in place: row i of *augmented is row i of A followed by b[i] (it is overwritten)
+void GuassianElimination(std::vector<double> *px, std::vector< std::vector<double> > *augmented);
 
 // PerpendicularDistance(): calculate the perpendicular distance from a point to a line
-double PerpendicularDistance(const std::vector<double> &direction, const std::vector<double> &point);
+double PerpendicularDistance(CArrayView<const double> direction, CArrayView<const double> point);
+// the same with the squared norm of the direction precomputed (e.g. CReferencePoint::squared_norm())
+double PerpendicularDistance(CArrayView<const double> direction, double squared_norm, CArrayView<const double> point);
 
-double length(const std::vector<double> &vector);
+// DotProducts(): out[i*R+r] = <points[i], directions[r]> for n points and R directions
+// (row-major matrices with M columns), computed four points at a time
+void DotProducts(const double *points, std::size_t n, const double *directions, std::size_t R, std::size_t M, double *out);
+
+double length(CArrayView<const double> vector);
 }
 
 #endif
@@ -0,0 +1,56 @@
+#include "aux_random.h"
+
+using std::uint64_t;
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+// ----------------------------------------------------------------------
+void CRandomGenerator::Seed(uint64_t seed)
+{
+	for (int i=0; i<4; i+=1)
+	{
+		uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		s_[i] = z ^ (z >> 31);
+	}
+}
+// ----------------------------------------------------------------------
+uint64_t CRandomGenerator::operator()()
+{
+	const uint64_t result = rotl(s_[0] + s_[3], 23) + s_[0];
+	const uint64_t t = s_[1] << 17;
+
+	s_[2] ^= s_[0];
+	s_[3] ^= s_[1];
+	s_[1] ^= s_[2];
+	s_[0] ^= s_[3];
+
+	s_[2] ^= t;
+	s_[3] = rotl(s_[3], 45);
+
+	return result;
+}
+// ----------------------------------------------------------------------
+void CRandomGenerator::Jump()
+{
+	static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+
+	uint64_t s[4] = { 0, 0, 0, 0 };
+	for (int i=0; i<4; i+=1)
+	{
+		for (int b=0; b<64; b+=1)
+		{
+			if (JUMP[i] & (uint64_t(1) << b))
+			{
+				for (int j=0; j<4; j+=1) s[j] ^= s_[j];
+			}
+			(*this)();
+		}
+	}
+
+	for (int j=0; j<4; j+=1) s_[j] = s[j];
+}
+// ----------------------------------------------------------------------
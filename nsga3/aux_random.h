@@ -0,0 +1,29 @@
+#ifndef RANDOM_AUX__
+#define RANDOM_AUX__
+
+#include <cstdint>
+
+// ----------------------------------------------------------------------
+//		CRandomGenerator: xoshiro256++ (Blackman and Vigna)
+//
+// A small and fast generator whose state can be advanced by 2^128 steps
+// with Jump(). Copying a generator and jumping the copy gives a stream
+// that does not overlap the original one, so each parallel worker can
+// have its own stream.
+// ----------------------------------------------------------------------
+class CRandomGenerator
+{
+public:
+	explicit CRandomGenerator(std::uint64_t seed = 0) { Seed(seed); }
+
+	void Seed(std::uint64_t seed); // the state is filled by splitmix64
+	std::uint64_t operator()();
+	double Uniform() { return static_cast<double>((*this)() >> 11) / 9007199254740992.0; } // [0, 1), 53 random bits
+
+	void Jump(); // equivalent to 2^128 calls of operator()
+
+private:
+	std::uint64_t s_[4];
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "aux_thread_pool.h"
+
+using std::size_t;
+
+// ----------------------------------------------------------------------
+CThreadPool::CThreadPool(size_t num_threads):
+	body_(0),
+	n_(0),
+	round_(0),
+	pending_(0),
+	stop_(false)
+{
+	if (num_threads == 0) num_threads = std::thread::hardware_concurrency();
+	if (num_threads == 0) num_threads = 1;
+
+	for (size_t w=1; w<num_threads; w+=1)
+	{
+		threads_.push_back(std::thread(&CThreadPool::WorkerLoop, this, w));
+	}
+}
+// ----------------------------------------------------------------------
+CThreadPool::~CThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	start_.notify_all();
+
+	for (size_t i=0; i<threads_.size(); i+=1)
+	{
+		threads_[i].join();
+	}
+}
+// ----------------------------------------------------------------------
+void CThreadPool::RunChunk(size_t worker) const
+{
+	size_t begin = n_*worker/size(),
+		   end = n_*(worker+1)/size();
+	if (begin < end) (*body_)(begin, end, worker);
+}
+// ----------------------------------------------------------------------
+void CThreadPool::ParallelFor(size_t n, const TBody &body)
+{
+	if (threads_.empty())
+	{
+		if (n > 0) body(0, n, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		body_ = &body;
+		n_ = n;
+		pending_ = threads_.size();
+		round_ += 1;
+	}
+	start_.notify_all();
+
+	RunChunk(0);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_.wait(lock, [this] { return pending_ == 0; });
+	body_ = 0;
+}
+// ----------------------------------------------------------------------
+void CThreadPool::WorkerLoop(size_t worker)
+{
+	size_t seen = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			start_.wait(lock, [&] { return stop_ || round_ != seen; });
+			if (stop_) return;
+			seen = round_;
+		}
+
+		RunChunk(worker);
+
+		bool last = false;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			pending_ -= 1;
+			last = (pending_ == 0);
+		}
+		if (last) done_.notify_one();
+	}
+}
+// ----------------------------------------------------------------------
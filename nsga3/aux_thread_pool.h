@@ -0,0 +1,55 @@
+#ifndef THREAD_POOL_AUX__
+#define THREAD_POOL_AUX__
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// ----------------------------------------------------------------------
+//		CThreadPool
+//
+// A fixed set of workers for data-parallel loops. The calling thread is
+// worker 0, so a pool of size 1 runs everything in the caller.
+//
+// ParallelFor() splits [0, n) into size() contiguous chunks of (almost)
+// equal length. Chunk w always goes to worker w, which keeps results
+// reproducible when each worker uses its own random stream.
+// ----------------------------------------------------------------------
+class CThreadPool
+{
+public:
+	typedef std::function<void (std::size_t begin, std::size_t end, std::size_t worker)> TBody;
+
+	explicit CThreadPool(std::size_t num_threads = 1); // 0: one per hardware thread
+	~CThreadPool();
+
+	std::size_t size() const { return threads_.size() + 1; }
+
+	void ParallelFor(std::size_t n, const TBody &body); // returns when all the chunks are done
+
+	// the same for any callable, which is referred to (not copied into a TBody, which may allocate)
+	template <typename TFunc>
+	void ParallelFor(std::size_t n, const TFunc &body) { ParallelFor(n, TBody(std::cref(body))); }
+
+private:
+	CThreadPool(const CThreadPool &);
+	CThreadPool & operator=(const CThreadPool &);
+
+	void RunChunk(std::size_t worker) const;
+	void WorkerLoop(std::size_t worker);
+
+	std::vector<std::thread> threads_;
+	std::mutex mutex_;
+	std::condition_variable start_, done_;
+
+	const TBody *body_;
+	std::size_t n_,
+				round_, // incremented by every ParallelFor()
+				pending_; // workers that have not finished the current round
+	bool stop_;
+};
+
+#endif
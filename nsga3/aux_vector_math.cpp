@@ -0,0 +1,145 @@
+#include "aux_vector_math.h"
+
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VECTOR_MATH_X86_SIMD
+#include <immintrin.h>
+#endif
+
+using std::size_t;
+
+namespace
+{
+// pi/2 split in three parts (Cody-Waite reduction)
+const double PIO2_1 = 1.57079625129699707031E0,
+			 PIO2_2 = 7.54978941586159635335E-8,
+			 PIO2_3 = 5.39030285815811905290E-15,
+			 TWO_OVER_PI = 6.36619772367581382433E-1;
+
+// Cephes sin() and cos() polynomials on [-pi/4, pi/4]
+const double S0 =  1.58962301576546568060E-10,
+			 S1 = -2.50507477628578072866E-8,
+			 S2 =  2.75573136213857245213E-6,
+			 S3 = -1.98412698295895385996E-4,
+			 S4 =  8.33333333332211858878E-3,
+			 S5 = -1.66666666666666307295E-1;
+
+const double C0 = -1.13585365213876817300E-11,
+			 C1 =  2.08757008419747316778E-9,
+			 C2 = -2.75573141792967388112E-7,
+			 C3 =  2.48015872888517045348E-5,
+			 C4 = -1.38888888888730564116E-3,
+			 C5 =  4.16666666666665929218E-2;
+
+// ----------------------------------------------------------------------
+void SinCosScalar(const double *a, size_t n, double *s, double *c)
+{
+	for (size_t i=0; i<n; i+=1)
+	{
+		double q = std::nearbyint(a[i]*TWO_OVER_PI);
+		double r = ((a[i] - q*PIO2_1) - q*PIO2_2) - q*PIO2_3,
+			   z = r*r;
+
+		double ps = r + r*z*(((((S0*z + S1)*z + S2)*z + S3)*z + S4)*z + S5),
+			   pc = 1.0 - 0.5*z + z*z*(((((C0*z + C1)*z + C2)*z + C3)*z + C4)*z + C5);
+
+		long quadrant = static_cast<long>(q) & 3;
+		double sv = (quadrant & 1) ? pc : ps,
+			   cv = (quadrant & 1) ? ps : pc;
+		if (quadrant >= 2) sv = -sv;
+		if (quadrant == 1 || quadrant == 2) cv = -cv;
+
+		if (s) s[i] = sv;
+		if (c) c[i] = cv;
+	}
+}
+
+#ifdef VECTOR_MATH_X86_SIMD
+// ----------------------------------------------------------------------
+// The same operations as SinCosScalar() (no FMA), so both give the same
+// results.
+// ----------------------------------------------------------------------
+__attribute__((target("avx2")))
+void SinCosAVX2(const double *a, size_t n, double *s, double *c)
+{
+	const __m256d sign = _mm256_set1_pd(-0.0), one = _mm256_set1_pd(1.0), half = _mm256_set1_pd(0.5),
+				  two = _mm256_set1_pd(2.0), quarter = _mm256_set1_pd(0.25), four = _mm256_set1_pd(4.0);
+
+	size_t i = 0;
+	for (; i+4<=n; i+=4)
+	{
+		__m256d x = _mm256_loadu_pd(a+i);
+		__m256d q = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(TWO_OVER_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+		__m256d r = _mm256_sub_pd(x, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_1)));
+		r = _mm256_sub_pd(r, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_2)));
+		r = _mm256_sub_pd(r, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_3)));
+		__m256d z = _mm256_mul_pd(r, r);
+
+		__m256d ps = _mm256_set1_pd(S0);
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, z), _mm256_set1_pd(S1));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, z), _mm256_set1_pd(S2));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, z), _mm256_set1_pd(S3));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, z), _mm256_set1_pd(S4));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, z), _mm256_set1_pd(S5));
+		ps = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, z), ps));
+
+		__m256d pc = _mm256_set1_pd(C0);
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, z), _mm256_set1_pd(C1));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, z), _mm256_set1_pd(C2));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, z), _mm256_set1_pd(C3));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, z), _mm256_set1_pd(C4));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, z), _mm256_set1_pd(C5));
+		pc = _mm256_add_pd(_mm256_sub_pd(one, _mm256_mul_pd(half, z)), _mm256_mul_pd(_mm256_mul_pd(z, z), pc));
+
+		// quadrant = q mod 4 in {0, 1, 2, 3}
+		__m256d quadrant = _mm256_sub_pd(q, _mm256_mul_pd(four, _mm256_floor_pd(_mm256_mul_pd(q, quarter))));
+		__m256d odd = _mm256_cmp_pd(_mm256_sub_pd(quadrant, _mm256_mul_pd(two, _mm256_floor_pd(_mm256_mul_pd(quadrant, half)))), one, _CMP_EQ_OQ),
+				sin_neg = _mm256_cmp_pd(quadrant, two, _CMP_GE_OQ),
+				cos_neg = _mm256_and_pd(_mm256_cmp_pd(quadrant, one, _CMP_GE_OQ), _mm256_cmp_pd(quadrant, two, _CMP_LE_OQ));
+
+		__m256d sv = _mm256_blendv_pd(ps, pc, odd),
+				cv = _mm256_blendv_pd(pc, ps, odd);
+		sv = _mm256_xor_pd(sv, _mm256_and_pd(sin_neg, sign));
+		cv = _mm256_xor_pd(cv, _mm256_and_pd(cos_neg, sign));
+
+		if (s) _mm256_storeu_pd(s+i, sv);
+		if (c) _mm256_storeu_pd(c+i, cv);
+	}
+
+	SinCosScalar(a+i, n-i, s ? s+i : 0, c ? c+i : 0);
+}
+#endif // VECTOR_MATH_X86_SIMD
+
+// ----------------------------------------------------------------------
+typedef void (*TSinCos)(const double *, size_t, double *, double *);
+
+TSinCos SelectSinCos()
+{
+#ifdef VECTOR_MATH_X86_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return SinCosAVX2;
+#endif
+	return SinCosScalar;
+}
+
+const TSinCos sincos_kernel = SelectSinCos();
+
+}// namespace
+
+
+namespace MathAux
+{
+// ----------------------------------------------------------------------
+void SinCos(const double *a, size_t n, double *s, double *c)
+{
+	sincos_kernel(a, n, s, c);
+}
+// ----------------------------------------------------------------------
+void Cos(const double *a, size_t n, double *c)
+{
+	sincos_kernel(a, n, 0, c);
+}
+// ----------------------------------------------------------------------
+}// namespace MathAux
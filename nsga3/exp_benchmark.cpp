@@ -0,0 +1,823 @@
+#include "exp_benchmark.h"
+#include "alg_comparator.h"
+#include "alg_nondominated_sort.h"
+#include "alg_association.h"
+#include "alg_reference_point.h"
+#include "alg_population.h"
+#include "alg_nsgaiii.h"
+#include "aux_math.h"
+#include "aux_thread_pool.h"
+#include "exp_indicator.h"
+#include "exp_hypervolume.h"
+#include "exp_front.h"
+#include "log.h"
+#include "exp_snapshot.h"
+#include "problem_DTLZ.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+#ifdef COUNT_ALLOCATIONS
+// ----------------------------------------------------------------------
+// Every allocation with new (which includes the standard containers) is
+// counted, for BenchmarkAllocations().
+// ----------------------------------------------------------------------
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // free() is matched by the malloc() below
+#endif
+
+static atomic<size_t> num_allocations(0);
+
+void * operator new(size_t size)
+{
+	num_allocations += 1;
+	if (void *p = malloc(size ? size : 1)) return p;
+	throw bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static size_t NumAllocations() { return num_allocations; }
+#else
+static size_t NumAllocations() { return 0; }
+#endif
+
+// ----------------------------------------------------------------------
+// RandomObjectives():
+//
+// Fill the objective vectors with f = c*t + (1-c)*u, where t and u are
+// uniform random numbers shared by / independent among the objectives.
+// c=0 gives a few large fronts; c close to 1 gives many small fronts,
+// which is what the early generations look like.
+// ----------------------------------------------------------------------
+static void RandomObjectives(CPopulation *pop, double c, CRandomGenerator *rng)
+{
+	for (size_t i=0; i<pop->size(); i+=1)
+	{
+		CIndividual::TObjVec &f = (*pop)[i].objs();
+
+		double t = MathAux::random(rng, 0.0, 1.0);
+		for (size_t m=0; m<f.size(); m+=1)
+		{
+			f[m] = c*t + (1-c)*MathAux::random(rng, 0.0, 1.0);
+		}
+	}
+}
+// ----------------------------------------------------------------------
+void BenchmarkNondominatedSort(ostream &os)
+{
+	const CParetoDominate dominate;
+	const CNondominatedSort::EEngine engines[] = {
+		CNondominatedSort::nsNaive,
+		CNondominatedSort::nsENS_SS,
+		CNondominatedSort::nsENS_BS,
+		CNondominatedSort::nsJensen
+	};
+	const size_t NumEngines = sizeof(engines)/sizeof(engines[0]);
+	const size_t Objectives[] = { 2, 3, 5, 8, 10, 15 };
+	const size_t PopSizes[] = { 100, 200, 500, 1000, 2000 };
+	const double Correlations[] = { 0.0, 0.9 };
+	const size_t NumRepeats = 5;
+
+	CRandomGenerator rng(1);
+
+	os << "Non-dominated sorting (ms per sort, average of " << NumRepeats << " sorts)" << endl;
+	os << "ranked = N/2 is the partial ranking used in the environmental selection" << endl;
+	os << "dominance kernel: " << DominanceKernelName(CurrentDominanceKernel()) << endl;
+	os << left << setw(4) << "M" << setw(7) << "N" << setw(6) << "corr" << setw(8) << "ranked" << setw(8) << "fronts";
+	for (size_t e=0; e<NumEngines; e+=1)
+	{
+		os << setw(10) << CNondominatedSort::EngineName(engines[e]);
+	}
+	os << endl;
+
+	for (double c : Correlations)
+	{
+		for (size_t M : Objectives)
+		{
+			for (size_t N : PopSizes)
+			{
+				CPopulation pop(N, 0, M);
+				RandomObjectives(&pop, c, &rng);
+
+				CNondominatedSort naive(dominate, CNondominatedSort::nsNaive);
+				CNondominatedSort::TFronts all_fronts = naive(pop);
+
+				for (size_t ranked : { N, N/2 })
+				{
+					// the fronts until the one where 'ranked' individuals are reached
+					CNondominatedSort::TFronts expected;
+					for (size_t t=0, num=0; t<all_fronts.size() && num<ranked; t+=1)
+					{
+						expected.push_back(all_fronts[t]);
+						num += all_fronts[t].size();
+					}
+
+					os << left << setw(4) << M << setw(7) << N << setw(6) << c << setw(8) << ranked << setw(8) << expected.size();
+					for (size_t e=0; e<NumEngines; e+=1)
+					{
+						CNondominatedSort sort(dominate, engines[e]);
+						CNondominatedSort::TFronts fronts;
+
+						auto start = chrono::steady_clock::now();
+						for (size_t r=0; r<NumRepeats; r+=1)
+						{
+							fronts = sort(pop, ranked);
+						}
+						chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+
+						os << setw(10) << fixed << setprecision(3) << elapsed.count()/NumRepeats << defaultfloat;
+						if (fronts != expected)
+						{
+							os << "(mismatch) ";
+						}
+					}
+					os << endl;
+				}
+			}
+		}
+	}
+
+}// BenchmarkNondominatedSort()
+// ----------------------------------------------------------------------
+void BenchmarkDominanceKernels(ostream &os)
+{
+	const DominanceKernel kernels[] = { dkScalar, dkAVX2, dkAVX512 };
+	const size_t NumKernels = sizeof(kernels)/sizeof(kernels[0]);
+	const size_t Objectives[] = { 2, 3, 5, 8, 10, 15 };
+	const size_t PopSizes[] = { 500, 2000 };
+	const double Correlations[] = { 0.0, 0.9 };
+	const size_t NumRepeats = 5;
+
+	const DominanceKernel original = CurrentDominanceKernel();
+	CRandomGenerator rng(1);
+
+	os << "Dominance kernels in ENS-BS sorting (ms per sort, average of " << NumRepeats << " sorts)" << endl;
+	os << left << setw(4) << "M" << setw(7) << "N" << setw(6) << "corr";
+	for (size_t k=0; k<NumKernels; k+=1)
+	{
+		os << setw(10) << DominanceKernelName(kernels[k]);
+	}
+	os << endl;
+
+	const CParetoDominate dominate;
+	CNondominatedSort sort(dominate, CNondominatedSort::nsENS_BS);
+	for (double c : Correlations)
+	{
+		for (size_t M : Objectives)
+		{
+			for (size_t N : PopSizes)
+			{
+				CPopulation pop(N, 0, M);
+				RandomObjectives(&pop, c, &rng);
+
+				UseDominanceKernel(dkScalar);
+				CNondominatedSort::TFronts expected = sort(pop);
+
+				os << left << setw(4) << M << setw(7) << N << setw(6) << c;
+				for (size_t k=0; k<NumKernels; k+=1)
+				{
+					if (!UseDominanceKernel(kernels[k]))
+					{
+						os << setw(10) << "n/a";
+						continue;
+					}
+
+					CNondominatedSort::TFronts fronts;
+					auto start = chrono::steady_clock::now();
+					for (size_t r=0; r<NumRepeats; r+=1)
+					{
+						fronts = sort(pop);
+					}
+					chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+
+					os << setw(10) << fixed << setprecision(3) << elapsed.count()/NumRepeats << defaultfloat;
+					if (fronts != expected)
+					{
+						os << "(mismatch) ";
+					}
+				}
+				os << endl;
+			}
+		}
+	}
+
+	UseDominanceKernel(original);
+
+}// BenchmarkDominanceKernels()
+// ----------------------------------------------------------------------
+// ReferenceDTLZ():
+//
+// The original O(M^2) definitions of DTLZ1-4 (problem = 1, ..., 4), which
+// the prefix-product and batch versions are checked against.
+// ----------------------------------------------------------------------
+static void ReferenceDTLZ(int problem, const double *x, size_t M, size_t k, double *f)
+{
+	const double alpha = (problem == 4 ? 100 : 1);
+
+	double g = 0;
+	for (size_t i = M-1; i < M+k-1; i += 1)
+	{
+		g += MathAux::square(x[i]-0.5) - ((problem == 1 || problem == 3) ? cos(20*MathAux::PI*(x[i]-0.5)) : 0.0);
+	}
+	if (problem == 1 || problem == 3) g = (k + g)*100;
+
+	for (size_t m = 0; m < M; m += 1)
+	{
+		double product = (problem == 1 ? 0.5*(1+g) : 1+g);
+		size_t i = 0;
+		for (; i+m<=M-2; i+=1)
+		{
+			product *= (problem == 1 ? x[i] : cos(pow(x[i], alpha)*MathAux::PI/2));
+		}
+		if (m > 0)
+			product *= (problem == 1 ? 1-x[i] : sin(pow(x[i], alpha)*MathAux::PI/2));
+
+		f[m] = product;
+	}
+}
+// ----------------------------------------------------------------------
+static BProblem * MakeDTLZ(int problem, size_t M)
+{
+	switch (problem)
+	{
+	case 1: return new CProblemDTLZ1(M);
+	case 2: return new CProblemDTLZ2(M);
+	case 3: return new CProblemDTLZ3(M);
+	default: return new CProblemDTLZ4(M);
+	}
+}
+// ----------------------------------------------------------------------
+void BenchmarkDTLZ(ostream &os)
+{
+	const size_t Objectives[] = { 3, 5, 8, 10, 15 };
+	const size_t N = 1000, NumRepeats = 20;
+	const double Tolerance = 1e-12; // relative to max(1, |f|)
+
+	CRandomGenerator rng(1);
+
+	os << "DTLZ evaluation (us per " << N << " individuals, average of " << NumRepeats << " repeats)" << endl;
+	os << "error: max |f - reference| / max(1, |reference|)" << endl;
+	os << left << setw(7) << "DTLZ" << setw(4) << "M" << setw(12) << "reference" << setw(12) << "Evaluate" << setw(12) << "Batch"
+	   << setw(12) << "err(Eval)" << setw(12) << "err(Batch)" << endl;
+
+	for (int problem=1; problem<=4; problem+=1)
+	{
+		for (size_t M : Objectives)
+		{
+			BProblem *prob = MakeDTLZ(problem, M);
+			const size_t nv = prob->num_variables(), k = nv-M+1;
+
+			CPopulation pop(N, nv, M), ref(N, nv, M), single(N, nv, M);
+			for (size_t i=0; i<N; i+=1)
+			{
+				for (size_t j=0; j<nv; j+=1) pop[i].vars()[j] = MathAux::random(&rng, 0.0, 1.0);
+				single[i] = ref[i] = pop[i];
+			}
+
+			auto start = chrono::steady_clock::now();
+			for (size_t r=0; r<NumRepeats; r+=1)
+			{
+				for (size_t i=0; i<N; i+=1) ReferenceDTLZ(problem, ref[i].vars().data(), M, k, ref[i].objs().data());
+			}
+			chrono::duration<double, micro> t_ref = chrono::steady_clock::now() - start;
+
+			start = chrono::steady_clock::now();
+			for (size_t r=0; r<NumRepeats; r+=1)
+			{
+				for (size_t i=0; i<N; i+=1) prob->Evaluate(&single[i]);
+			}
+			chrono::duration<double, micro> t_single = chrono::steady_clock::now() - start;
+
+			start = chrono::steady_clock::now();
+			for (size_t r=0; r<NumRepeats; r+=1)
+			{
+				prob->EvaluateBatch(&pop, 0, N);
+			}
+			chrono::duration<double, micro> t_batch = chrono::steady_clock::now() - start;
+
+			double err_single = 0, err_batch = 0;
+			for (size_t i=0; i<N; i+=1)
+			{
+				for (size_t m=0; m<M; m+=1)
+				{
+					double f = ref[i].objs()[m], scale = max(1.0, fabs(f));
+					err_single = max(err_single, fabs(single[i].objs()[m]-f)/scale);
+					err_batch = max(err_batch, fabs(pop[i].objs()[m]-f)/scale);
+				}
+			}
+
+			os << left << setw(7) << problem << setw(4) << M << fixed << setprecision(1)
+			   << setw(12) << t_ref.count()/NumRepeats << setw(12) << t_single.count()/NumRepeats << setw(12) << t_batch.count()/NumRepeats
+			   << defaultfloat << setprecision(3) << setw(12) << err_single << setw(12) << err_batch;
+			if (err_single > Tolerance || err_batch > Tolerance)
+			{
+				os << "(mismatch) ";
+			}
+			os << setprecision(6) << endl;
+
+			delete prob;
+		}
+	}
+
+}// BenchmarkDTLZ()
+// ----------------------------------------------------------------------
+void BenchmarkAssociation(ostream &os)
+{
+	// the settings of the original paper (two layers for 8 and more objectives)
+	struct { size_t M, p1, p2; } settings[] = { {3, 12, 0}, {5, 6, 0}, {8, 3, 2}, {10, 3, 2}, {15, 2, 1}, {10, 6, 0}, {15, 4, 2} };
+	const size_t NumRepeats = 5;
+
+	CRandomGenerator rng(1);
+
+	os << "Association of 2*|R| points (ms, average of " << NumRepeats << " repeats)" << endl;
+	os << left << setw(4) << "M" << setw(8) << "p" << setw(7) << "|R|";
+	const CAssociation::EEngine engine_types[] = { CAssociation::asBruteForce, CAssociation::asBallTree, CAssociation::asDense };
+	const size_t NumEngines = sizeof(engine_types)/sizeof(engine_types[0]);
+	for (size_t e=0; e<NumEngines; e+=1) os << setw(12) << CAssociation::EngineName(engine_types[e]);
+	os << endl;
+
+	for (auto &setting : settings)
+	{
+		vector<size_t> p(1, setting.p1);
+		if (setting.p2 > 0) p.push_back(setting.p2);
+
+		vector<CReferencePoint> rps;
+		GenerateReferencePoints(&rps, setting.M, p);
+
+		// normalized objectives: mostly around the unit simplex, some far from it
+		const size_t N = 2*rps.size();
+		CPopulation pop(N, 0, setting.M);
+		for (size_t i=0; i<N; i+=1)
+		{
+			double scale = MathAux::random(&rng, 0.5, i%10 == 0 ? 5.0 : 1.5), sum = 0;
+			CIndividual::TObjVec &f = pop[i].conv_objs();
+			for (size_t m=0; m<f.size(); m+=1) sum += (f[m] = MathAux::random(&rng, 0.0, 1.0));
+			for (size_t m=0; m<f.size(); m+=1) f[m] *= scale/sum;
+		}
+
+		vector<size_t> members(N);
+		for (size_t i=0; i<N; i+=1) members[i] = i;
+
+		vector< vector<size_t> > nearest(NumEngines, vector<size_t>(N));
+		vector< vector<double> > dist(NumEngines, vector<double>(N));
+
+		os << left << setw(4) << setting.M << setw(8) << (to_string(setting.p1) + (setting.p2 ? "," + to_string(setting.p2) : "")) << setw(7) << rps.size();
+
+		bool mismatch = false;
+		for (size_t e=0; e<NumEngines; e+=1)
+		{
+			CAssociation engine(rps, engine_types[e]);
+
+			auto start = chrono::steady_clock::now();
+			for (size_t r=0; r<NumRepeats; r+=1)
+			{
+				engine.Nearest(rps, pop, members.data(), N, nearest[e].data(), dist[e].data());
+			}
+			chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+			os << setw(12) << fixed << setprecision(3) << elapsed.count()/NumRepeats << defaultfloat;
+
+			mismatch = mismatch || nearest[e] != nearest[0] || dist[e] != dist[0];
+		}
+
+		if (mismatch)
+		{
+			os << "(mismatch) ";
+		}
+		os << endl;
+	}
+
+}// BenchmarkAssociation()
+// ----------------------------------------------------------------------
+void BenchmarkAllocations(ostream &os)
+{
+	struct { size_t M; const char *p; } settings[] = { {3, "12"}, {5, "6"}, {8, "3 2"} };
+	const size_t Generations = 100;
+
+#ifdef COUNT_ALLOCATIONS
+	os << "Heap allocations of NSGA-III on DTLZ2, generations " << Generations << "-" << 2*Generations-1 << endl;
+#else
+	os << "Allocations are not counted (build with COUNT_ALLOCATIONS defined)" << endl;
+#endif
+	os << left << setw(4) << "M" << setw(10) << "version" << setw(14) << "allocations" << setw(14) << "ms/generation" << endl;
+
+	for (auto &setting : settings)
+	{
+		BProblem *prob = MakeDTLZ(2, setting.M);
+
+		for (int improved=0; improved<2; improved+=1)
+		{
+			// The runs with G and 2G generations share their first G generations,
+			// so the difference is what the generations G, ..., 2G-1 cost.
+			size_t allocations[2] = {0, 0};
+			double elapsed_ms[2] = {0, 0};
+			for (size_t g=1; g<=2; g+=1)
+			{
+				istringstream config(string("algorithm.name = NSGAIII\n") +
+									 "objective.division.p = " + setting.p + "\n" +
+									 "generation.number = " + to_string(g*Generations) + "\n" +
+									 "crossover.rate = 1.0\ncrossover.eta = 30\nmutation.eta = 20\n");
+				CNSGAIII nsgaiii;
+				nsgaiii.Setup(config);
+
+				CPopulation solutions;
+				size_t before = NumAllocations();
+				auto start = chrono::steady_clock::now();
+				nsgaiii.Solve(&solutions, *prob, improved != 0, 1);
+				chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+				allocations[g-1] = NumAllocations() - before;
+				elapsed_ms[g-1] = elapsed.count();
+			}
+
+			os << left << setw(4) << setting.M << setw(10) << (improved ? "improved" : "original");
+			os << setw(14) << (allocations[1] - allocations[0]);
+			os << setw(14) << fixed << setprecision(3) << (elapsed_ms[1] - elapsed_ms[0])/Generations << defaultfloat << endl;
+		}
+
+		delete prob;
+	}
+
+}// BenchmarkAllocations()
+// ----------------------------------------------------------------------
+// ScanIndicators(): IGD, IGD+, GD and GD+ by plain scans, as the reference
+// ----------------------------------------------------------------------
+static SIndicators ScanIndicators(const TFront &PF, const TFront &A)
+{
+	auto nearest = [](const CObjectiveVector &q, const TFront &points, int metric) // 0: d, 1: d+ (point worse), 2: d+ (q worse)
+	{
+		double best = numeric_limits<double>::max();
+		for (const CObjectiveVector &p : points)
+		{
+			double d = 0;
+			for (size_t k=0; k<q.size(); k+=1)
+			{
+				double t = (metric == 0 ? p[k]-q[k] : (metric == 1 ? max(p[k]-q[k], 0.0) : max(q[k]-p[k], 0.0)));
+				d += t*t;
+			}
+			best = min(best, d);
+		}
+		return sqrt(best);
+	};
+
+	SIndicators result = { 0, 0, 0, 0 };
+	for (const CObjectiveVector &z : PF)
+	{
+		result.IGD += nearest(z, A, 0);
+		result.IGD_plus += nearest(z, A, 1);
+	}
+	for (const CObjectiveVector &a : A)
+	{
+		result.GD += nearest(a, PF, 0);
+		result.GD_plus += nearest(a, PF, 2);
+	}
+	result.IGD /= PF.size(); result.IGD_plus /= PF.size();
+	result.GD /= A.size(); result.GD_plus /= A.size();
+	return result;
+}
+// ----------------------------------------------------------------------
+static void RandomSpherePoints(TFront *front, size_t n, size_t M, double max_scale, CRandomGenerator *rng)
+{
+	front->assign(n, CObjectiveVector());
+	for (size_t i=0; i<n; i+=1)
+	{
+		double len = 0;
+		vector<double> f(M);
+		for (size_t k=0; k<M; k+=1)
+		{
+			// |N(0, 1)| (Box-Muller), so the direction is uniform on the positive part of the sphere
+			double u1 = MathAux::random(rng, 0.0, 1.0), u2 = MathAux::random(rng, 0.0, 1.0);
+			f[k] = fabs(sqrt(-2*log(1.0 - u1))*cos(2*MathAux::PI*u2));
+			len += f[k]*f[k];
+		}
+		double scale = MathAux::random(rng, 1.0, max_scale)/sqrt(len);
+		for (size_t k=0; k<M; k+=1) (*front)[i].push_back(f[k]*scale);
+	}
+}
+// ----------------------------------------------------------------------
+void BenchmarkIndicators(ostream &os)
+{
+	const size_t Objectives[] = { 3, 5, 8, 10, 15 };
+	const size_t PFSize = 10000, ApproxSize = 300, NumRepeats = 3;
+
+	CRandomGenerator rng(1);
+	CThreadPool pool(0);
+
+	os << "IGD, IGD+, GD and GD+ of " << ApproxSize << " points against a PF of " << PFSize << " points on the unit sphere (ms, average of " << NumRepeats << " repeats)" << endl;
+	os << left << setw(4) << "M" << setw(12) << "scan" << setw(12) << "kd-tree" << setw(12) << "blocked"
+	   << setw(12) << ("auto/" + to_string(pool.size()) + "T") << "IGD" << endl;
+
+	for (size_t M : Objectives)
+	{
+		TFront PF, A;
+		RandomSpherePoints(&PF, PFSize, M, 1.0, &rng);
+		RandomSpherePoints(&A, ApproxSize, M, 1.1, &rng);
+
+		SIndicators results[4];
+		double elapsed_ms[4] = {};
+		for (size_t v=0; v<4; v+=1)
+		{
+			auto start = chrono::steady_clock::now();
+			for (size_t r=0; r<NumRepeats; r+=1)
+			{
+				switch (v)
+				{
+				case 0: results[v] = ScanIndicators(PF, A); break;
+				case 1: results[v] = ComputeIndicators(PF, A, 0, nsKdTree); break;
+				case 2: results[v] = ComputeIndicators(PF, A, 0, nsBlocked); break;
+				default: results[v] = ComputeIndicators(PF, A, &pool, nsAuto);
+				}
+			}
+			elapsed_ms[v] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()/NumRepeats;
+		}
+
+		os << left << setw(4) << M << fixed << setprecision(2);
+		for (size_t v=0; v<4; v+=1) os << setw(12) << elapsed_ms[v];
+		os << defaultfloat << setprecision(6) << results[0].IGD;
+		for (size_t v=1; v<4; v+=1)
+		{
+			if (results[v].IGD != results[0].IGD || results[v].IGD_plus != results[0].IGD_plus ||
+				results[v].GD != results[0].GD || results[v].GD_plus != results[0].GD_plus)
+			{
+				os << " (mismatch)";
+				break;
+			}
+		}
+		os << endl;
+	}
+
+}// BenchmarkIndicators()
+// ----------------------------------------------------------------------
+void BenchmarkHypervolume(ostream &os)
+{
+	const size_t Objectives[] = { 3, 5, 6, 8, 10, 15 };
+	const size_t FrontSize = 200;
+
+	CRandomGenerator rng(1);
+	CThreadPool pool(0);
+
+	os << "Hypervolume of " << FrontSize << " points on the unit sphere, reference point 1.1 (ms; Monte Carlo with "
+	   << HypervolumeDefaultSamples << " samples)" << endl;
+	os << left << setw(4) << "M" << setw(12) << "exact" << setw(12) << "MC/1T" << setw(12) << ("MC/" + to_string(pool.size()) + "T")
+	   << setw(12) << "HV" << "MC estimate [95% CI]" << endl;
+
+	for (size_t M : Objectives)
+	{
+		TFront front;
+		RandomSpherePoints(&front, FrontSize, M, 1.0, &rng);
+		vector<double> reference(M, 1.1);
+
+		SHypervolume exact = { -1, -1, -1, true }, mc[2] = {};
+		double elapsed_ms[3] = { -1, -1, -1 };
+		for (size_t v=0; v<3; v+=1)
+		{
+			if (v == 0 && M > HypervolumeExactMaxObjectives) continue;
+
+			auto start = chrono::steady_clock::now();
+			switch (v)
+			{
+			case 0: exact = Hypervolume(front, reference, hvExact); break;
+			case 1: mc[0] = Hypervolume(front, reference, hvMonteCarlo, 0); break;
+			default: mc[1] = Hypervolume(front, reference, hvMonteCarlo, &pool);
+			}
+			elapsed_ms[v] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		}
+
+		os << left << setw(4) << M << fixed << setprecision(2);
+		for (size_t v=0; v<3; v+=1)
+		{
+			if (elapsed_ms[v] < 0) os << setw(12) << "-";
+			else os << setw(12) << elapsed_ms[v];
+		}
+		os << defaultfloat << setprecision(6) << setw(12);
+		if (exact.value < 0) os << "-";
+		else os << exact.value;
+		os << mc[0].value << " [" << mc[0].lower << ", " << mc[0].upper << "]";
+		if (exact.value >= 0 && (exact.value < mc[0].lower || exact.value > mc[0].upper)) os << " (outside)";
+		if (mc[1].value != mc[0].value) os << " (depends on the threads)";
+		os << endl;
+	}
+
+}// BenchmarkHypervolume()
+// ----------------------------------------------------------------------
+void BenchmarkFrontFiles(ostream &os)
+{
+	const size_t Objectives[] = { 3, 8, 15 };
+	const size_t FrontSize = 20000, NumRepeats = 5;
+	const string TextFile = "BENCH_front.txt", BinaryFile = "BENCH_front.bin";
+
+	CRandomGenerator rng(1);
+
+	os << "Loading a front of " << FrontSize << " points (ms, average of " << NumRepeats << " repeats)" << endl;
+	os << left << setw(4) << "M" << setw(14) << "LoadFront" << setw(14) << "text" << setw(14) << "binary" << "points" << endl;
+
+	for (size_t M : Objectives)
+	{
+		TFront front;
+		RandomSpherePoints(&front, FrontSize, M, 1.0, &rng);
+		{
+			ofstream ofile(TextFile);
+			for (const CObjectiveVector &f : front) ofile << f << endl;
+		}
+		ConvertFrontFile(TextFile, BinaryFile);
+
+		TFront loaded;
+		CFront text, binary;
+		double elapsed_ms[3] = {};
+		for (size_t v=0; v<3; v+=1)
+		{
+			auto start = chrono::steady_clock::now();
+			for (size_t r=0; r<NumRepeats; r+=1)
+			{
+				switch (v)
+				{
+				case 0: LoadFront(loaded, TextFile); break;
+				case 1: text.LoadText(TextFile); break;
+				default: binary.LoadBinary(BinaryFile);
+				}
+			}
+			elapsed_ms[v] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()/NumRepeats;
+		}
+
+		bool same = (loaded.size() == text.size() && text.size() == binary.size() &&
+					 text.num_objectives() == M && binary.num_objectives() == M);
+		for (size_t i=0; same && i<text.size(); i+=1)
+		{
+			for (size_t k=0; k<M; k+=1)
+			{
+				same = same && loaded[i][k] == text[i][k] && text[i][k] == binary[i][k];
+			}
+		}
+
+		os << left << setw(4) << M << fixed << setprecision(3);
+		for (size_t v=0; v<3; v+=1) os << setw(14) << elapsed_ms[v];
+		os << defaultfloat << text.size() << (same ? "" : " (mismatch)") << endl;
+	}
+
+	remove(TextFile.c_str());
+	remove(BinaryFile.c_str());
+
+}// BenchmarkFrontFiles()
+// ----------------------------------------------------------------------
+// LegacySaveScatterData(): the former SaveScatterData(), as the reference
+// ----------------------------------------------------------------------
+static void LegacySaveScatterData(const string &fname, const CPopulation &pop, ios_base::openmode mode)
+{
+	ofstream ofile(fname.c_str(), mode);
+	for (size_t i=0; i<pop.size(); i+=1)
+	{
+		for (size_t j=0; j<pop[i].vars().size(); j+=1) ofile << pop[i].vars()[j] << ' ';
+		for (size_t f=0; f<pop[i].objs().size(); f+=1) ofile << pop[i].objs()[f] << ' ';
+		ofile << endl;
+	}
+	ofile << endl;
+}
+// ----------------------------------------------------------------------
+void BenchmarkResultWriter(ostream &os)
+{
+	const size_t PopSize = 136, NumVars = 24, NumObjs = 15, Generations = 200;
+	const string FileName = "BENCH_results";
+
+	CRandomGenerator rng(1);
+	CPopulation pop(PopSize, NumVars, NumObjs);
+	for (size_t i=0; i<PopSize*NumVars; i+=1) pop.vars_data()[i] = rng.Uniform();
+	for (size_t i=0; i<PopSize*NumObjs; i+=1) pop.objs_data()[i] = rng.Uniform()*2;
+
+	os << "Writing " << Generations << " generations of " << PopSize << " individuals with "
+	   << NumVars << " variables and " << NumObjs << " objectives (ms, MB)" << endl;
+	os << left << setw(24) << "writer" << setw(12) << "time" << setw(12) << "size" << "read back" << endl;
+
+	const char *names[] = { "ofstream (6 digits)", "text", "binary", "binary columns", "text, gzip", "binary columns, gzip" };
+	const LogFormat formats[] = { lfText, lfText, lfBinary, lfBinaryColumns, lfText, lfBinaryColumns };
+	for (size_t v=0; v<6; v+=1)
+	{
+		bool compress = (v >= 4);
+		if (compress && !CResultWriter::CompressionAvailable()) { os << setw(24) << names[v] << "(zlib not available)" << endl; continue; }
+
+		auto start = chrono::steady_clock::now();
+		if (v == 0)
+		{
+			for (size_t g=0; g<Generations; g+=1) LegacySaveScatterData(FileName, pop, g == 0 ? ios_base::out : ios_base::app);
+		}
+		else
+		{
+			CResultWriter writer;
+			writer.Open(FileName, formats[v], compress);
+			for (size_t g=0; g<Generations; g+=1) writer.Write(pop, ldAll);
+			writer.Close();
+		}
+		double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+		ifstream ifile(FileName, ios::binary | ios::ate);
+		double size_mb = ifile.tellg()/1048576.0;
+		ifile.close();
+
+		// the objectives of one generation read back
+		string check;
+		if (v >= 1 && v <= 2)
+		{
+			CResultWriter writer;
+			writer.Open(FileName, formats[v]);
+			writer.Write(pop);
+			writer.Close();
+
+			CFront front;
+			if (v == 1) front.LoadText(FileName);
+			else front.LoadBinary(FileName);
+
+			bool same = (front.size() == PopSize && front.num_objectives() == NumObjs &&
+						 equal(pop.objs_data(), pop.objs_data() + PopSize*NumObjs, front.data()));
+			check = (same ? "exact" : "mismatch");
+		}
+
+		os << left << setw(24) << names[v] << fixed << setprecision(2) << setw(12) << elapsed_ms << setw(12) << size_mb
+		   << defaultfloat << check << endl;
+	}
+
+	remove(FileName.c_str());
+
+}// BenchmarkResultWriter()
+// ----------------------------------------------------------------------
+void BenchmarkSnapshots(ostream &os)
+{
+	const size_t M = 15, Generations = 200;
+	const string FileName = "BENCH_snapshots.bin";
+
+	BProblem *prob = MakeDTLZ(2, M);
+	istringstream config("algorithm.name = NSGAIII\nobjective.division.p = 2 1\ngeneration.number = " + to_string(Generations) +
+						 "\ncrossover.rate = 1.0\ncrossover.eta = 30\nmutation.eta = 20\n");
+	CNSGAIII nsgaiii;
+	nsgaiii.Setup(config);
+
+	os << "NSGA-III on DTLZ2(" << M << "), " << Generations << " generations, with snapshots (ms, MB)" << endl;
+	os << left << setw(24) << "snapshots" << setw(12) << "time" << setw(12) << "size" << "read back" << endl;
+
+	const char *names[] = { "none", "every 10th", "every one", "every one, variables" };
+	const size_t intervals[] = { 0, 10, 1, 1 };
+	for (size_t v=0; v<4; v+=1)
+	{
+		bool variables = (v == 3);
+
+		CPopulation solutions;
+		CSnapshotStream snapshots;
+		auto start = chrono::steady_clock::now();
+		if (intervals[v] > 0) snapshots.Open(FileName, intervals[v], M, variables ? prob->num_variables() : 0);
+		nsgaiii.Solve(&solutions, *prob, false, 1, 0, &snapshots);
+		snapshots.Close();
+		double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+		os << left << setw(24) << names[v] << fixed << setprecision(2) << setw(12) << elapsed_ms;
+		if (intervals[v] == 0) { os << defaultfloat << endl; continue; }
+
+		ifstream ifile(FileName, ios::binary | ios::ate);
+		os << setw(12) << ifile.tellg()/1048576.0 << defaultfloat;
+		ifile.close();
+
+		// one record per generation taken, the last one being the final population
+		CSnapshotReader reader;
+		vector<double> values;
+		bool same = reader.Open(FileName) && reader.size() == Generations/intervals[v] + 1 &&
+					reader.generation(reader.size()-1) == Generations && reader.Read(reader.size()-1, &values) &&
+					reader.rows(reader.size()-1) == solutions.size();
+		size_t columns = reader.num_variables() + M;
+		for (size_t i=0; same && i<solutions.size(); i+=1)
+		{
+			same = equal(solutions[i].objs().begin(), solutions[i].objs().end(), &values[i*columns + reader.num_variables()]) &&
+				   (!variables || equal(solutions[i].vars().begin(), solutions[i].vars().end(), &values[i*columns]));
+		}
+		os << (same ? "exact" : "mismatch") << endl;
+	}
+
+	remove(FileName.c_str());
+	delete prob;
+
+}// BenchmarkSnapshots()
+// ----------------------------------------------------------------------
+bool RunBenchmark(const string &name, ostream &os)
+{
+	if (name == "NDSort") BenchmarkNondominatedSort(os);
+	else if (name == "Dominance") BenchmarkDominanceKernels(os);
+	else if (name == "DTLZ") BenchmarkDTLZ(os);
+	else if (name == "Associate") BenchmarkAssociation(os);
+	else if (name == "Allocations") BenchmarkAllocations(os);
+	else if (name == "Indicators") BenchmarkIndicators(os);
+	else if (name == "Hypervolume") BenchmarkHypervolume(os);
+	else if (name == "FrontFiles") BenchmarkFrontFiles(os);
+	else if (name == "ResultWriter") BenchmarkResultWriter(os);
+	else if (name == "Snapshots") BenchmarkSnapshots(os);
+	else return false;
+
+	return true;
+}
+// ----------------------------------------------------------------------
@@ -0,0 +1,67 @@
+#ifndef BENCHMARK__
+#define BENCHMARK__
+
+#include <string>
+#include <iostream>
+
+// ----------------------------------------------------------------------
+// Micro-benchmarks of the building blocks of NSGA-III.
+//
+// They are run by listing "BENCH_<name>" in explist.ini, e.g. BENCH_NDSort.
+// ----------------------------------------------------------------------
+
+// Compare the non-dominated sorting engines across population sizes and
+// numbers of objectives, with full and partial ranking. The fronts of
+// every engine are checked against the naive engine.
+void BenchmarkNondominatedSort(std::ostream &os);
+
+// Compare the scalar, AVX2 and AVX-512 Pareto dominance kernels in the
+// ENS-BS engine. Kernels not supported by the CPU are skipped.
+void BenchmarkDominanceKernels(std::ostream &os);
+
+// Compare the evaluation of DTLZ1-4 one by one (Evaluate) and in a batch
+// (EvaluateBatch) with their original O(M^2) definitions, in time and in
+// the maximum relative error.
+void BenchmarkDTLZ(std::ostream &os);
+
+// Compare the association engines on the reference point sets of the
+// original paper. The results of every engine are checked against the
+// brute-force scan.
+void BenchmarkAssociation(std::ostream &os);
+
+// Count the heap allocations in the generations of NSGA-III after a
+// warm-up (only when built with COUNT_ALLOCATIONS defined; otherwise only
+// the time is measured). The steady state is expected not to allocate.
+void BenchmarkAllocations(std::ostream &os);
+
+// Compare the computation of IGD, IGD+, GD and GD+ by plain scans, with
+// a k-d tree, with blocked scans and with the default choice on all the
+// hardware threads. The results must be the same as the scans.
+void BenchmarkIndicators(std::ostream &os);
+
+// Compare the exact hypervolume (up to 6 objectives) with the Monte Carlo
+// estimate on one and on all the hardware threads. The exact value must
+// lie in the confidence interval, and the estimate must not depend on the
+// number of threads.
+void BenchmarkHypervolume(std::ostream &os);
+
+// Compare the loading of a front by LoadFront(), from the same text file
+// into a CFront, and from its binary version (mapped). All three must
+// give the same points.
+void BenchmarkFrontFiles(std::ostream &os);
+
+// Compare the former ofstream-based result files with CResultWriter in
+// text, binary and columnar formats (and gzip, when built with zlib), in
+// time and size. One generation written as text and as binary must read
+// back exactly.
+void BenchmarkResultWriter(std::ostream &os);
+
+// Run NSGA-III on a 15-objective problem without snapshots and with snapshot
+// logs of some or all generations (see CSnapshotStream). The last snapshot
+// read back must be the final population.
+void BenchmarkSnapshots(std::ostream &os);
+
+// Run the benchmark with the given name. Return false if there is no such benchmark.
+bool RunBenchmark(const std::string &name, std::ostream &os);
+
+#endif
@@ -0,0 +1,220 @@
+#include "exp_front.h"
+#include "exp_indicator.h"
+#include "alg_population.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FRONT_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+const char BinaryFrontMagic[8] = { 'N', 'S', 'G', 'A', 'F', 'R', 'N', 'T' };
+
+namespace
+{
+struct SBinaryFrontHeader
+{
+	char magic[8];
+	uint64_t num_objectives, num_points;
+};
+}
+
+// ---------------------------------------------------------------------
+CFront::CFront():
+	data_(0),
+	n_(0),
+	M_(0),
+	map_(0),
+	map_size_(0)
+{
+}
+// ---------------------------------------------------------------------
+CFront::CFront(const TFront &front):
+	data_(0),
+	n_(front.size()),
+	M_(front.empty() ? 0 : front[0].size()),
+	map_(0),
+	map_size_(0)
+{
+	storage_.assign(n_*M_, 0.0);
+	for (size_t i=0; i<n_; i+=1)
+	{
+		for (size_t k=0; k<M_ && k<front[i].size(); k+=1)
+		{
+			storage_[i*M_ + k] = front[i][k];
+		}
+	}
+	data_ = storage_.data();
+}
+// ---------------------------------------------------------------------
+CFront::CFront(const double *data, size_t n, size_t M):
+	data_(data),
+	n_(n),
+	M_(M),
+	map_(0),
+	map_size_(0)
+{
+}
+// ---------------------------------------------------------------------
+CFront::CFront(const CPopulation &pop):
+	data_(pop.objs_data()),
+	n_(pop.size()),
+	M_(pop.num_objectives()),
+	map_(0),
+	map_size_(0)
+{
+}
+// ---------------------------------------------------------------------
+CFront::~CFront()
+{
+	Clear();
+}
+// ---------------------------------------------------------------------
+void CFront::Clear()
+{
+#ifdef FRONT_MMAP
+	if (map_) munmap(map_, map_size_);
+#endif
+	map_ = 0;
+	map_size_ = 0;
+	storage_.clear();
+	data_ = 0;
+	n_ = M_ = 0;
+}
+// ---------------------------------------------------------------------
+// The same points as LoadFront(): one per line up to the first empty line,
+// with the number of objectives of the first line (the values missing in a
+// shorter line are 0). The file is read at once and parsed with strtod().
+// ---------------------------------------------------------------------
+bool CFront::LoadText(const string &fname)
+{
+	Clear();
+
+	ifstream ifile(fname, ios::binary);
+	if (!ifile) return false;
+	string text((istreambuf_iterator<char>(ifile)), istreambuf_iterator<char>());
+
+	const char *p = text.c_str();
+	while (true)
+	{
+		const char *eol = strchr(p, '\n');
+		if (!eol) eol = p + strlen(p);
+
+		size_t count = 0;
+		char *end = 0;
+		for (double v = strtod(p, &end); end != p && end <= eol; v = strtod(p, &end))
+		{
+			if (n_ == 0) M_ += 1;
+			if (count < M_) storage_.push_back(v);
+			count += 1;
+			p = end;
+		}
+		if (count == 0) break; // an empty line ends the front
+
+		storage_.resize((n_+1)*M_, 0.0);
+		n_ += 1;
+
+		if (*eol == '\0') break;
+		p = eol + 1;
+	}
+
+	data_ = storage_.data();
+	return true;
+}
+// ---------------------------------------------------------------------
+bool CFront::LoadBinary(const string &fname)
+{
+	Clear();
+
+	SBinaryFrontHeader header;
+	ifstream ifile(fname, ios::binary);
+	if (!ifile || !ifile.read(reinterpret_cast<char *>(&header), sizeof(header))) return false;
+	if (memcmp(header.magic, BinaryFrontMagic, sizeof(header.magic)) != 0) return false;
+
+	// the sizes come from the file: reject those whose product would overflow
+	if (header.num_points > 0 && (header.num_objectives == 0 ||
+		header.num_points > (SIZE_MAX - sizeof(header))/sizeof(double)/header.num_objectives)) return false;
+
+	size_t num_values = header.num_points*header.num_objectives,
+		   file_size = sizeof(header) + num_values*sizeof(double);
+	ifile.seekg(0, ios::end);
+	if ((size_t)ifile.tellg() != file_size) return false; // truncated
+	ifile.close();
+
+#ifdef FRONT_MMAP
+	int fd = open(fname.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+	void *map = mmap(0, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) return false;
+
+	map_ = map;
+	map_size_ = file_size;
+	data_ = reinterpret_cast<const double *>(static_cast<const char *>(map) + sizeof(header));
+#else
+	storage_.resize(num_values);
+	ifile.open(fname, ios::binary);
+	ifile.seekg(sizeof(header));
+	if (!ifile.read(reinterpret_cast<char *>(storage_.data()), num_values*sizeof(double))) { storage_.clear(); return false; }
+	data_ = storage_.data();
+#endif
+	n_ = header.num_points;
+	M_ = header.num_objectives;
+	return true;
+}
+// ---------------------------------------------------------------------
+bool SaveBinaryFront(const string &fname, const CFront &front)
+{
+	SBinaryFrontHeader header;
+	memcpy(header.magic, BinaryFrontMagic, sizeof(header.magic));
+	header.num_objectives = front.num_objectives();
+	header.num_points = front.size();
+
+	ofstream ofile(fname, ios::binary);
+	ofile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	ofile.write(reinterpret_cast<const char *>(front.data()), front.size()*front.num_objectives()*sizeof(double));
+	return bool(ofile);
+}
+// ---------------------------------------------------------------------
+bool ConvertFrontFile(const string &text_fname, const string &binary_fname)
+{
+	CFront front;
+	return front.LoadText(text_fname) && !front.empty() && SaveBinaryFront(binary_fname, front);
+}
+// ---------------------------------------------------------------------
+CFrontCache::SEntry & CFrontCache::Load(const string &base)
+{
+	SEntry &entry = fronts_[base];
+	if (!entry.front)
+	{
+		shared_ptr<CFront> loaded = make_shared<CFront>();
+		if (!loaded->LoadBinary(base + ".bin")) loaded->LoadText(base + ".txt");
+		entry.front = loaded;
+	}
+	return entry;
+}
+// ---------------------------------------------------------------------
+shared_ptr<const CFront> CFrontCache::Get(const string &base)
+{
+	lock_guard<mutex> lock(mutex_);
+	return Load(base).front;
+}
+// ---------------------------------------------------------------------
+shared_ptr<const CPointIndex> CFrontCache::GetIndex(const string &base)
+{
+	lock_guard<mutex> lock(mutex_);
+
+	SEntry &entry = Load(base);
+	if (!entry.index) entry.index = make_shared<CPointIndex>(*entry.front);
+	return entry.index;
+}
+// ---------------------------------------------------------------------
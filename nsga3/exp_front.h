@@ -0,0 +1,95 @@
+#ifndef FRONT__
+#define FRONT__
+
+#include "exp_indicator.h"
+#include "aux_array_view.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class CPopulation;
+class CPointIndex;
+
+// ---------------------------------------------------------------------
+//		CFront: a read-only front of n points with M objectives, stored
+//		point by point in one contiguous array
+//
+// A front is loaded from a text file (one point per line, as LoadFront())
+// or from a binary front file, which is memory-mapped and used in place.
+// It can also be a view of points stored elsewhere, e.g. of the objectives
+// of a population, which must then outlive it.
+//
+// Binary front files (*.bin): the 8 characters of BinaryFrontMagic, the
+// number of objectives M and the number of points n (uint64, in the byte
+// order of the machine), then the n*M objective values as doubles.
+// ---------------------------------------------------------------------
+class CFront
+{
+public:
+	CFront();
+	explicit CFront(const TFront &front); // copied
+	CFront(const double *data, std::size_t n, std::size_t M); // a view
+	explicit CFront(const CPopulation &pop); // a view of the objectives
+	~CFront();
+
+	bool LoadText(const std::string &fname); // false if the file cannot be read
+	bool LoadBinary(const std::string &fname); // false if the file cannot be read or is not a front file
+
+	std::size_t size() const { return n_; }
+	bool empty() const { return n_ == 0; }
+	std::size_t num_objectives() const { return M_; }
+	bool mapped() const { return map_ != 0; }
+
+	const double * data() const { return data_; }
+	CArrayView<const double> operator[](std::size_t i) const { return CArrayView<const double>(data_ + i*M_, M_); }
+
+private:
+	CFront(const CFront &);
+	CFront & operator=(const CFront &);
+
+	void Clear();
+
+	const double *data_;
+	std::size_t n_, M_;
+	std::vector<double> storage_; // when the front is not mapped
+	void *map_;
+	std::size_t map_size_;
+};
+
+extern const char BinaryFrontMagic[8];
+
+bool SaveBinaryFront(const std::string &fname, const CFront &front);
+bool ConvertFrontFile(const std::string &text_fname, const std::string &binary_fname); // false if there is no point
+
+// ---------------------------------------------------------------------
+//		CFrontCache
+//
+// Every front is loaded once per process: from base + ".bin" when it
+// exists, otherwise from base + ".txt" (e.g. base = "PF/DTLZ1(3)-PF").
+// A missing front is an empty one. The nearest neighbour index of a front
+// (for GD and GD+) is also built once, when it is first asked for. Get()
+// and GetIndex() may be called from any thread.
+// ---------------------------------------------------------------------
+class CFrontCache
+{
+public:
+	std::shared_ptr<const CFront> Get(const std::string &base);
+	std::shared_ptr<const CPointIndex> GetIndex(const std::string &base);
+
+private:
+	struct SEntry
+	{
+		std::shared_ptr<const CFront> front;
+		std::shared_ptr<const CPointIndex> index;
+	};
+	SEntry & Load(const std::string &base); // with mutex_ locked
+
+	std::mutex mutex_;
+	std::map<std::string, SEntry> fronts_;
+};
+
+#endif
@@ -0,0 +1,309 @@
+#include "exp_hypervolume.h"
+#include "exp_front.h"
+#include "alg_comparator.h"
+#include "aux_random.h"
+#include "aux_thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace std;
+
+// ---------------------------------------------------------------------
+// The rows of the point sets below have a stride of M objectives, of which
+// only the first d are used (d decreases while the WFG recursion slices
+// off the last objective).
+// ---------------------------------------------------------------------
+static bool WeaklyDominates(const double *l, const double *r, size_t d)
+{
+	for (size_t k=0; k<d; k+=1)
+	{
+		if (l[k] > r[k]) return false;
+	}
+	return true;
+}
+// ---------------------------------------------------------------------
+// Appends q to the m rows unless one of them weakly dominates it, and
+// removes the rows it dominates, so the rows stay mutually nondominated.
+// ---------------------------------------------------------------------
+static void InsertNondominated(vector<double> *rows, size_t *m, const double *q, size_t M, size_t d)
+{
+	double *p = rows->data();
+	for (size_t j=0; j<*m; j+=1)
+	{
+		if (WeaklyDominates(p + j*M, q, d)) return;
+	}
+
+	size_t j = 0;
+	while (j < *m)
+	{
+		if (WeaklyDominates(q, p + j*M, d))
+		{
+			*m -= 1;
+			copy_n(p + (*m)*M, d, p + j*M);
+		}
+		else j += 1;
+	}
+
+	if (rows->size() < (*m+1)*M) { rows->resize((*m+1)*M); p = rows->data(); }
+	copy_n(q, d, p + (*m)*M);
+	*m += 1;
+}
+// ---------------------------------------------------------------------
+//		CWfg
+//
+// WFG: the volume of n nondominated points sorted by the last objective
+// is the sum of the slices between consecutive values of that objective:
+//
+//   V_d(P) = sum_i (r_d - p_i,d) * (I_{d-1}(p_i) - V_{d-1}(L_i))
+//
+// where I is the volume dominated by a single point and L_i the limit set
+// of p_i: the nondominated points max(p_i, p_j), j < i, in d-1 objectives.
+// There is one buffer per number of objectives, so the recursion does not
+// allocate once the buffers have grown.
+// ---------------------------------------------------------------------
+class CWfg
+{
+public:
+	explicit CWfg(const vector<double> &reference):
+		ref_(reference),
+		M_(reference.size()),
+		levels_(M_+1),
+		sorted_(M_+1),
+		order_(M_+1),
+		limit_(M_)
+	{}
+
+	// points: n mutually nondominated rows that dominate the reference (reordered)
+	double operator()(vector<double> *points, size_t n)
+	{
+		levels_[M_].swap(*points);
+		double volume = Volume(M_, n);
+		levels_[M_].swap(*points);
+		return volume;
+	}
+
+private:
+	double Inclusive(const double *p, size_t d) const
+	{
+		double volume = 1;
+		for (size_t k=0; k<d; k+=1) volume *= ref_[k] - p[k];
+		return volume;
+	}
+
+	double Volume(size_t d, size_t n);
+	void SortByObjective(size_t d, size_t n, size_t k);
+	bool LimitSet(size_t d, size_t i, size_t *m); // false if a p_j dominates p_i (nothing exclusive)
+
+	const vector<double> &ref_;
+	size_t M_;
+	vector< vector<double> > levels_, sorted_;
+	vector< vector<size_t> > order_;
+	vector<double> limit_;
+};
+// ---------------------------------------------------------------------
+double CWfg::Volume(size_t d, size_t n)
+{
+	if (n == 0) return 0;
+	const double *P = levels_[d].data();
+	if (n == 1) return Inclusive(P, d);
+
+	if (d == 1)
+	{
+		double best = ref_[0];
+		for (size_t i=0; i<n; i+=1) best = std::min(best, P[i*M_]);
+		return ref_[0] - best;
+	}
+
+	SortByObjective(d, n, d-1);
+	P = levels_[d].data();
+
+	double volume = 0;
+	if (d == 2) // a sweep: the exclusive part of each slice is bounded by the best first objective so far
+	{
+		double best = ref_[0];
+		for (size_t i=0; i<n; i+=1)
+		{
+			const double *p = P + i*M_;
+			if (p[0] < best)
+			{
+				volume += (ref_[1] - p[1]) * (best - p[0]);
+				best = p[0];
+			}
+		}
+		return volume;
+	}
+
+	for (size_t i=0; i<n; i+=1)
+	{
+		const double *p = levels_[d].data() + i*M_;
+		size_t m = 0;
+		if (!LimitSet(d, i, &m)) continue;
+
+		double exclusive = Inclusive(p, d-1) - Volume(d-1, m);
+		volume += (ref_[d-1] - p[d-1]) * exclusive;
+	}
+	return volume;
+}
+// ---------------------------------------------------------------------
+void CWfg::SortByObjective(size_t d, size_t n, size_t k)
+{
+	const vector<double> &P = levels_[d];
+	vector<size_t> &order = order_[d];
+	order.resize(n);
+	iota(order.begin(), order.end(), 0);
+	sort(order.begin(), order.end(), [&](size_t a, size_t b) { return P[a*M_ + k] < P[b*M_ + k]; });
+
+	vector<double> &sorted = sorted_[d];
+	sorted.resize(n*M_);
+	for (size_t i=0; i<n; i+=1)
+	{
+		copy_n(&P[order[i]*M_], d, &sorted[i*M_]);
+	}
+	levels_[d].swap(sorted);
+}
+// ---------------------------------------------------------------------
+bool CWfg::LimitSet(size_t d, size_t i, size_t *m)
+{
+	const double *P = levels_[d].data(), *p = P + i*M_;
+	for (size_t j=0; j<i; j+=1)
+	{
+		const double *q = P + j*M_;
+		if (WeaklyDominates(q, p, d-1)) return false;
+
+		for (size_t k=0; k<d-1; k+=1)
+		{
+			limit_[k] = std::max(p[k], q[k]);
+		}
+		InsertNondominated(&levels_[d-1], m, limit_.data(), M_, d-1);
+	}
+	return true;
+}
+// ---------------------------------------------------------------------
+// The fraction of the box [ideal, reference] dominated by the points,
+// estimated from num_samples uniform samples in NumBatches batches.
+// ---------------------------------------------------------------------
+static SHypervolume MonteCarlo(const vector<double> &points, size_t n, const vector<double> &ref,
+							   CThreadPool *pool, size_t num_samples, uint64_t seed)
+{
+	const size_t M = ref.size(), NumBatches = 64;
+
+	vector<double> ideal(ref);
+	for (size_t i=0; i<n; i+=1)
+	{
+		for (size_t k=0; k<M; k+=1) ideal[k] = std::min(ideal[k], points[i*M + k]);
+	}
+	double box = 1;
+	for (size_t k=0; k<M; k+=1) box *= ref[k] - ideal[k];
+
+	// the rows are tested from the last one, so the points dominating the most come last
+	vector<double> inclusive(n, 1.0);
+	for (size_t i=0; i<n; i+=1)
+	{
+		for (size_t k=0; k<M; k+=1) inclusive[i] *= ref[k] - points[i*M + k];
+	}
+	vector<size_t> rows(n);
+	iota(rows.begin(), rows.end(), 0);
+	sort(rows.begin(), rows.end(), [&](size_t a, size_t b) { return inclusive[a] < inclusive[b]; });
+
+	vector<CRandomGenerator> streams(NumBatches, CRandomGenerator(seed));
+	for (size_t b=1; b<NumBatches; b+=1)
+	{
+		streams[b] = streams[b-1];
+		streams[b].Jump();
+	}
+
+	vector<size_t> hits(NumBatches, 0);
+	auto body = [&](size_t begin, size_t end, size_t)
+	{
+		vector<double> sample(M);
+		for (size_t b=begin; b<end; b+=1)
+		{
+			CRandomGenerator &rng = streams[b];
+			size_t batch_size = num_samples*(b+1)/NumBatches - num_samples*b/NumBatches;
+			for (size_t s=0; s<batch_size; s+=1)
+			{
+				for (size_t k=0; k<M; k+=1)
+				{
+					sample[k] = ideal[k] + rng.Uniform()*(ref[k] - ideal[k]);
+				}
+				hits[b] += AnyParetoDominates(points.data(), rows.data(), n, sample.data(), M);
+			}
+		}
+	};
+	if (pool) pool->ParallelFor(NumBatches, body);
+	else body(0, NumBatches, 0);
+
+	double p = (double)accumulate(hits.begin(), hits.end(), (size_t)0)/num_samples,
+		   half_width = 1.96*std::sqrt(p*(1-p)/num_samples)*box;
+
+	SHypervolume result;
+	result.value = p*box;
+	result.lower = std::max(result.value - half_width, 0.0);
+	result.upper = std::min(result.value + half_width, box);
+	result.exact = false;
+	return result;
+}
+// ---------------------------------------------------------------------
+SHypervolume Hypervolume(const CFront &front, const vector<double> &reference,
+						 EHypervolumeMode mode, CThreadPool *pool, size_t num_samples, uint64_t seed)
+{
+	const size_t M = reference.size();
+	bool exact = (mode == hvExact || (mode == hvAuto && M <= HypervolumeExactMaxObjectives));
+
+	// the nondominated points that dominate the reference point
+	vector<double> points;
+	size_t n = 0;
+	for (size_t i=0; i<front.size() && front.num_objectives() == M; i+=1)
+	{
+		const double *p = front[i].data();
+
+		bool inside = true;
+		for (size_t k=0; k<M; k+=1)
+		{
+			inside = inside && p[k] < reference[k];
+		}
+		if (inside) InsertNondominated(&points, &n, p, M, M);
+	}
+
+	SHypervolume result = { 0, 0, 0, true };
+	if (n == 0 || (!exact && num_samples == 0)) return result;
+
+	if (!exact) return MonteCarlo(points, n, reference, pool, num_samples, seed);
+
+	CWfg wfg(reference);
+	result.value = result.lower = result.upper = wfg(&points, n);
+	return result;
+}
+// ---------------------------------------------------------------------
+SHypervolume Hypervolume(const TFront &front, const vector<double> &reference,
+						 EHypervolumeMode mode, CThreadPool *pool, size_t num_samples, uint64_t seed)
+{
+	return Hypervolume(CFront(front), reference, mode, pool, num_samples, seed);
+}
+// ---------------------------------------------------------------------
+vector<double> HypervolumeReferencePoint(const CFront &front, double margin)
+{
+	if (front.empty()) return vector<double>();
+
+	const size_t M = front.num_objectives();
+	vector<double> ideal(front[0].begin(), front[0].end()), nadir(ideal);
+	for (size_t i=1; i<front.size(); i+=1)
+	{
+		for (size_t k=0; k<M; k+=1)
+		{
+			ideal[k] = std::min(ideal[k], front[i][k]);
+			nadir[k] = std::max(nadir[k], front[i][k]);
+		}
+	}
+
+	vector<double> reference(M);
+	for (size_t k=0; k<M; k+=1)
+	{
+		double range = (nadir[k] > ideal[k] ? nadir[k] - ideal[k] : 1.0); // a flat objective still gets a margin
+		reference[k] = nadir[k] + margin*range;
+	}
+	return reference;
+}
+// ---------------------------------------------------------------------
@@ -0,0 +1,50 @@
+#ifndef HYPERVOLUME__
+#define HYPERVOLUME__
+
+#include "exp_indicator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ---------------------------------------------------------------------
+// Hypervolume: the volume of the objective space that is dominated by a
+// front and dominates the reference point (minimization). Points that do
+// not dominate the reference point add nothing.
+//
+// Up to HypervolumeExactMaxObjectives objectives it is computed exactly
+// with the WFG algorithm (While, Bradstreet and Barone, IEEE TEC 2012).
+// Above, it is estimated by Monte Carlo sampling of the box between the
+// ideal point of the front and the reference point; every sample is
+// tested with the Pareto dominance kernels (AnyParetoDominates()). The
+// samples are drawn in batches with their own random streams, so the
+// estimate only depends on the seed, not on the number of threads.
+//
+// [lower, upper] is the 95% confidence interval of an estimate (both are
+// the value itself when it is exact).
+// ---------------------------------------------------------------------
+struct SHypervolume
+{
+	double value, lower, upper;
+	bool exact;
+};
+
+enum EHypervolumeMode { hvAuto, hvExact, hvMonteCarlo };
+const std::size_t HypervolumeExactMaxObjectives = 6;
+const std::size_t HypervolumeDefaultSamples = 100000;
+
+class CThreadPool;
+class CFront;
+
+// pool (optional): the sample batches are shared among its workers
+SHypervolume Hypervolume(const CFront &front, const std::vector<double> &reference,
+						 EHypervolumeMode mode = hvAuto, CThreadPool *pool = 0,
+						 std::size_t num_samples = HypervolumeDefaultSamples, std::uint64_t seed = 0);
+SHypervolume Hypervolume(const TFront &front, const std::vector<double> &reference,
+						 EHypervolumeMode mode = hvAuto, CThreadPool *pool = 0,
+						 std::size_t num_samples = HypervolumeDefaultSamples, std::uint64_t seed = 0);
+
+// nadir + margin*(nadir - ideal) of the given points, e.g. of the PF
+std::vector<double> HypervolumeReferencePoint(const CFront &front, double margin = 0.1);
+
+#endif
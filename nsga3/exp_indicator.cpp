@@ -1,10 +1,12 @@
 
 #include "exp_indicator.h"
+#include "exp_front.h"
 #include <sstream>
 #include <fstream>
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include "aux_thread_pool.h"
 using namespace std;
 
 ostream & operator << (ostream &os, const CObjectiveVector &objvec)
@@ -18,8 +20,8 @@ ostream & operator << (ostream &os, const CObjectiveVector &objvec)
 // ---------------------------------------------------------------------
 istream & operator >> (istream &is, CObjectiveVector &objvec)
 {
-	char str[1000]={};
-	is.getline(str, 1000);
+	string str;
+	getline(is, str);
 
 	istringstream iss(str);
 
@@ -49,28 +51,274 @@ TFront & LoadFront(TFront &front, const std::string &infname) // return the numb
 	return front;
 }
 // ---------------------------------------------------------------------
-double EuclideanDistance(const CObjectiveVector &l, const CObjectiveVector &r)
+//		Nearest neighbour search
+//
+// The distances are compared squared. A metric gives the term of one
+// objective and a lower bound of that term over an interval [lo, hi]
+// (a side of a bounding box). The terms are added in the order of the
+// objectives, so the minimum is exactly the one of a plain scan.
+// ---------------------------------------------------------------------
+struct SEuclidean // d(q, p)
 {
-	double sum = 0;
-	for (size_t i=0; i<l.size(); i+=1)
+	static double Term(double q, double p) { double d = p-q; return d*d; }
+	static double BoxTerm(double q, double lo, double hi) { double d = (q < lo ? lo-q : (q > hi ? q-hi : 0.0)); return d*d; }
+};
+
+// d+ (Ishibuchi et al., EMO 2015): only the objectives in which one vector is
+// worse (larger, for minimization) than the other count
+struct SPointWorse // p worse than q: IGD+ (q in the PF, p in the approximation)
+{
+	static double Term(double q, double p) { double d = std::max(p-q, 0.0); return d*d; }
+	static double BoxTerm(double q, double lo, double) { double d = std::max(lo-q, 0.0); return d*d; }
+};
+
+struct SQueryWorse // q worse than p: GD+ (q in the approximation, p in the PF)
+{
+	static double Term(double q, double p) { double d = std::max(q-p, 0.0); return d*d; }
+	static double BoxTerm(double q, double, double hi) { double d = std::max(q-hi, 0.0); return d*d; }
+};
+
+const size_t CPointIndex::LeafSize, CPointIndex::BlockSize;
+// ---------------------------------------------------------------------
+CPointIndex::CPointIndex(const CFront &points, ENearestSearch search):
+	M_(points.num_objectives()),
+	n_(points.size()),
+	use_tree_(search == nsKdTree || (search == nsAuto && M_ <= KdTreeMaxObjectives))
+{
+	if (n_ == 0) return;
+
+	if (use_tree_)
+	{
+		points_.assign(points.data(), points.data() + n_*M_);
+
+		vector<size_t> order(n_);
+		for (size_t i=0; i<n_; i+=1) order[i] = i;
+		Build(&order, 0, n_);
+
+		for (size_t i=0; i<n_; i+=1) // the points of each leaf are contiguous
+		{
+			std::copy_n(points[order[i]].data(), M_, &points_[i*M_]);
+		}
+	}
+	else
 	{
-		sum += pow(l[i]-r[i],2);
+		size_t num_blocks = (n_ + BlockSize - 1)/BlockSize;
+		blocks_.assign(num_blocks*M_*BlockSize, 0.0);
+		for (size_t i=0; i<n_; i+=1)
+		{
+			size_t b = i/BlockSize, j = i%BlockSize;
+			for (size_t k=0; k<M_; k+=1)
+			{
+				blocks_[(b*M_ + k)*BlockSize + j] = points[i][k];
+			}
+		}
 	}
-	return sqrt(sum);
 }
 // ---------------------------------------------------------------------
-double IGD(const TFront &PF, const TFront &approximation)
+size_t CPointIndex::Build(vector<size_t> *porder, size_t first, size_t last)
 {
-	double sum = 0;
-	for (size_t p=0; p<PF.size(); p+=1)
+	vector<size_t> &order = *porder;
+
+	size_t node = nodes_.size();
+	SNode leaf = { first, last, 0, 0 };
+	nodes_.push_back(leaf);
+
+	lo_.resize(lo_.size() + M_, numeric_limits<double>::max());
+	hi_.resize(hi_.size() + M_, -numeric_limits<double>::max());
+	double *lo = &lo_[node*M_], *hi = &hi_[node*M_];
+	for (size_t i=first; i<last; i+=1)
 	{
-		double min_dist = numeric_limits<double>::max();
-		for (size_t a=0; a<approximation.size(); a+=1)
+		for (size_t k=0; k<M_; k+=1)
 		{
-			min_dist = min(min_dist, EuclideanDistance(PF[p], approximation[a]));
+			lo[k] = std::min(lo[k], points_[order[i]*M_ + k]);
+			hi[k] = std::max(hi[k], points_[order[i]*M_ + k]);
 		}
-		sum += min_dist;
 	}
-	return PF.size()>0?sum/PF.size():-1;
+
+	if (last - first <= LeafSize) return node;
+
+	size_t axis = 0;
+	for (size_t k=1; k<M_; k+=1)
+	{
+		if (hi[k]-lo[k] > hi[axis]-lo[axis]) axis = k;
+	}
+	if (hi[axis] == lo[axis]) return node; // all the points are the same
+
+	size_t mid = first + (last-first)/2;
+	std::nth_element(order.begin()+first, order.begin()+mid, order.begin()+last, [&](size_t a, size_t b)
+	{
+		return points_[a*M_ + axis] < points_[b*M_ + axis];
+	});
+
+	size_t left = Build(porder, first, mid);
+	size_t right = Build(porder, mid, last);
+	nodes_[node].left = left;
+	nodes_[node].right = right;
+	return node;
+}
+// ---------------------------------------------------------------------
+template <typename TMetric>
+double CPointIndex::BoxBound(const double *q, size_t node) const
+{
+	const double *lo = &lo_[node*M_], *hi = &hi_[node*M_];
+
+	double bound = 0;
+	for (size_t k=0; k<M_; k+=1)
+	{
+		bound += TMetric::BoxTerm(q[k], lo[k], hi[k]);
+	}
+	return bound;
+}
+// ---------------------------------------------------------------------
+template <typename TMetric>
+void CPointIndex::SearchTree(const double *q, size_t node, double *best) const
+{
+	const SNode &nd = nodes_[node];
+	if (nd.left == 0) // leaf
+	{
+		for (size_t i=nd.first; i<nd.last; i+=1)
+		{
+			const double *p = &points_[i*M_];
+			double d = 0;
+			for (size_t k=0; k<M_; k+=1)
+			{
+				d += TMetric::Term(q[k], p[k]);
+			}
+			*best = std::min(*best, d);
+		}
+		return;
+	}
+
+	double bl = BoxBound<TMetric>(q, nd.left), br = BoxBound<TMetric>(q, nd.right);
+	size_t near = nd.left, far = nd.right;
+	if (br < bl) { std::swap(near, far); std::swap(bl, br); }
+
+	if (bl < *best) SearchTree<TMetric>(q, near, best);
+	if (br < *best) SearchTree<TMetric>(q, far, best);
+}
+// ---------------------------------------------------------------------
+template <typename TMetric1, typename TMetric2>
+void CPointIndex::SearchBlocks(const double *q, double *best1, double *best2) const
+{
+	*best1 = *best2 = numeric_limits<double>::max();
+	for (size_t first=0, b=0; first<n_; first+=BlockSize, b+=1)
+	{
+		const double *block = &blocks_[b*M_*BlockSize];
+
+		double d1[BlockSize] = {}, d2[BlockSize] = {};
+		for (size_t k=0; k<M_; k+=1)
+		{
+			const double *column = block + k*BlockSize;
+			for (size_t j=0; j<BlockSize; j+=1)
+			{
+				d1[j] += TMetric1::Term(q[k], column[j]);
+				d2[j] += TMetric2::Term(q[k], column[j]);
+			}
+		}
+
+		size_t valid = std::min(BlockSize, n_-first);
+		for (size_t j=0; j<valid; j+=1)
+		{
+			*best1 = std::min(*best1, d1[j]);
+			*best2 = std::min(*best2, d2[j]);
+		}
+	}
+}
+// ---------------------------------------------------------------------
+template <typename TMetric>
+double CPointIndex::NearestSquared(const double *q) const
+{
+	double best = numeric_limits<double>::max(), unused;
+	if (!use_tree_) SearchBlocks<TMetric, TMetric>(q, &best, &unused);
+	else if (n_ > 0) SearchTree<TMetric>(q, 0, &best);
+	return best;
+}
+// ---------------------------------------------------------------------
+template <typename TMetric1, typename TMetric2>
+void CPointIndex::NearestSquared(const double *q, double *d1, double *d2) const
+{
+	if (use_tree_) // the boxes prune differently under the two metrics
+	{
+		*d1 = NearestSquared<TMetric1>(q);
+		*d2 = NearestSquared<TMetric2>(q);
+	}
+	else SearchBlocks<TMetric1, TMetric2>(q, d1, d2); // one scan for both
+}
+
+// ---------------------------------------------------------------------
+// For each query, the distance to the nearest point of the index under
+// two metrics. The distances are stored and summed in order afterwards,
+// so the result does not depend on the number of threads.
+// ---------------------------------------------------------------------
+template <typename TMetric1, typename TMetric2>
+static void MeanNearest(double *mean1, double *mean2, const CPointIndex &index, const CFront &queries, CThreadPool *pool)
+{
+	size_t n = queries.size();
+	vector<double> d1(n), d2(n);
+
+	auto body = [&](size_t begin, size_t end, size_t)
+	{
+		for (size_t i=begin; i<end; i+=1)
+		{
+			index.NearestSquared<TMetric1, TMetric2>(queries[i].data(), &d1[i], &d2[i]);
+			d1[i] = std::sqrt(d1[i]);
+			d2[i] = std::sqrt(d2[i]);
+		}
+	};
+	if (pool) pool->ParallelFor(n, body);
+	else body(0, n, 0);
+
+	double sum1 = 0, sum2 = 0;
+	for (size_t i=0; i<n; i+=1)
+	{
+		sum1 += d1[i];
+		sum2 += d2[i];
+	}
+	*mean1 = sum1/n;
+	*mean2 = sum2/n;
+}
+// ---------------------------------------------------------------------
+SIndicators ComputeIndicators(const CFront &PF, const CPointIndex &PF_index, const CFront &approximation, CThreadPool *pool, ENearestSearch search)
+{
+	SIndicators result = { -1, -1, -1, -1 };
+	if (PF.empty() || approximation.empty() || PF.num_objectives() != approximation.num_objectives()) return result;
+
+	// IGD and IGD+: from each point of the PF to the approximation
+	CPointIndex approx_index(approximation, search);
+	MeanNearest<SEuclidean, SPointWorse>(&result.IGD, &result.IGD_plus, approx_index, PF, pool);
+
+	// GD and GD+: from each point of the approximation to the PF
+	MeanNearest<SEuclidean, SQueryWorse>(&result.GD, &result.GD_plus, PF_index, approximation, pool);
+
+	return result;
+}
+// ---------------------------------------------------------------------
+SIndicators ComputeIndicators(const CFront &PF, const CFront &approximation, CThreadPool *pool, ENearestSearch search)
+{
+	return ComputeIndicators(PF, CPointIndex(PF, search), approximation, pool, search);
+}
+// ---------------------------------------------------------------------
+SIndicators ComputeIndicators(const TFront &PF, const TFront &approximation, CThreadPool *pool, ENearestSearch search)
+{
+	return ComputeIndicators(CFront(PF), CFront(approximation), pool, search);
+}
+// ---------------------------------------------------------------------
+double IGD(const CFront &PF, const CFront &approximation)
+{
+	if (PF.empty() || approximation.empty() || PF.num_objectives() != approximation.num_objectives()) return -1;
+
+	CPointIndex index(approximation);
+
+	double sum = 0;
+	for (size_t p=0; p<PF.size(); p+=1)
+	{
+		sum += std::sqrt(index.NearestSquared<SEuclidean>(PF[p].data()));
+	}
+	return sum/PF.size();
+}
+// ---------------------------------------------------------------------
+double IGD(const TFront &PF, const TFront &approximation)
+{
+	return IGD(CFront(PF), CFront(approximation));
 }
 // ---------------------------------------------------------------------
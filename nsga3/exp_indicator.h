@@ -28,6 +28,94 @@ typedef std::vector<CObjectiveVector> TFront;
 
 
 TFront & LoadFront(TFront &front, const std::string &infname); // return the number of vectors loaded successfully
+
+// ---------------------------------------------------------------------
+// The indicators are means of nearest neighbour distances (-1 if a front
+// is empty, or if the fronts do not have the same number of objectives):
+//
+//   IGD, IGD+: from each point of the PF to the approximation
+//   GD, GD+  : from each point of the approximation to the PF
+//
+// IGD+ and GD+ use the distance d+ of Ishibuchi et al. (EMO 2015), which
+// only counts the objectives in which the approximation is worse than the
+// PF (minimization).
+//
+// The nearest neighbours are found with a k-d tree up to
+// KdTreeMaxObjectives objectives and by a blocked scan above (nsAuto).
+// All the searches give the same distances as a plain scan.
+// ---------------------------------------------------------------------
+struct SIndicators
+{
+	double IGD, IGD_plus, GD, GD_plus;
+};
+
+enum ENearestSearch { nsAuto, nsKdTree, nsBlocked };
+const size_t KdTreeMaxObjectives = 8;
+
+class CThreadPool;
+class CFront;
+
+// ---------------------------------------------------------------------
+//		CPointIndex
+//
+// A set of M-dimensional points for nearest neighbour queries.
+//
+// For few objectives it is a k-d tree: each node splits its points at the
+// median of the widest objective and keeps their bounding box, and a query
+// skips the nodes whose box is not closer than the best point found so far.
+//
+// With many objectives the boxes hardly prune anything, so the points are
+// scanned in blocks of BlockSize stored objective by objective; the inner
+// loop then runs over the points of a block and is vectorized.
+//
+// An index copies its points, so it may outlive the front. It is queried
+// with the metrics of the indicators (in exp_indicator.cpp).
+// ---------------------------------------------------------------------
+class CPointIndex
+{
+public:
+	explicit CPointIndex(const CFront &points, ENearestSearch search = nsAuto);
+
+	template <typename TMetric>
+	double NearestSquared(const double *q) const; // the smallest squared distance to a point
+	template <typename TMetric1, typename TMetric2>
+	void NearestSquared(const double *q, double *d1, double *d2) const; // the same under two metrics at once
+
+private:
+	static const size_t LeafSize = 16, BlockSize = 64;
+
+	struct SNode
+	{
+		size_t first, last, // the points [first, last) in tree order
+			   left, right; // children (0 for a leaf, since the root is node 0)
+	};
+
+	std::size_t Build(std::vector<std::size_t> *order, std::size_t first, std::size_t last);
+
+	template <typename TMetric>
+	double BoxBound(const double *q, std::size_t node) const;
+	template <typename TMetric>
+	void SearchTree(const double *q, std::size_t node, double *best) const;
+	template <typename TMetric1, typename TMetric2>
+	void SearchBlocks(const double *q, double *best1, double *best2) const;
+
+	std::size_t M_, n_;
+	bool use_tree_;
+
+	std::vector<double> points_; // row-major, in tree order (tree)
+	std::vector<SNode> nodes_;
+	std::vector<double> lo_, hi_; // the bounding box of each node (M values per node)
+
+	std::vector<double> blocks_; // blocks_[(b*M + k)*BlockSize + j]: objective k of point b*BlockSize+j (blocks)
+};
+
+// pool (optional): the points of each front are shared among its workers
+SIndicators ComputeIndicators(const CFront &PF, const CFront &approximation, CThreadPool *pool = 0, ENearestSearch search = nsAuto);
+// PF_index: an index of the PF built once for many approximations (see CFrontCache)
+SIndicators ComputeIndicators(const CFront &PF, const CPointIndex &PF_index, const CFront &approximation,
+							  CThreadPool *pool = 0, ENearestSearch search = nsAuto);
+SIndicators ComputeIndicators(const TFront &PF, const TFront &approximation, CThreadPool *pool = 0, ENearestSearch search = nsAuto);
+double IGD(const CFront &PF, const CFront &approximation);
 double IGD(const TFront &PF, const TFront &approximation);
 
 
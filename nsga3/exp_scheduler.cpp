@@ -0,0 +1,296 @@
+#include "exp_scheduler.h"
+#include "exp_experiment.h"
+#include "exp_indicator.h"
+#include "exp_hypervolume.h"
+#include "exp_front.h"
+#include "exp_snapshot.h"
+#include "alg_nsgaiii.h"
+#include "alg_population.h"
+#include "problem_base.h"
+#include "aux_thread_pool.h"
+#include "aux_math.h"
+#include "aux_misc.h"
+#include "log.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+// ----------------------------------------------------------------------
+// The statistics of the IGD values of an experiment
+// ----------------------------------------------------------------------
+template <typename It>
+static auto mean(It begin, It end)
+{
+	using T = typename iterator_traits<It>::value_type;
+	auto size = (T)distance(begin, end);
+	auto sum = accumulate(begin, end, (T)0);
+	return sum / size;
+}
+
+template <typename It>
+static auto median(It begin, It end)
+{
+	using T = typename iterator_traits<It>::value_type;
+	vector<T> data(begin, end);
+	nth_element(data.begin(), data.begin() + data.size() / 2, data.end());
+	return data[data.size() / 2];
+}
+
+static auto stddev(vector<double> &inp)
+{
+	auto mean_val = mean(inp.begin(), inp.end());
+	double sq_sum = 0.0;
+	for (auto el : inp)
+	{
+		sq_sum += MathAux::square(el - mean_val);
+	}
+	return sqrt(sq_sum) / (double)inp.size();
+}
+
+static void print_analysis_result(ostream &os, const string& metrics, double value)
+{
+	os << left << setw(8) << setfill(' ') << metrics << ": " << value << endl;
+}
+
+static void print_summary(ostream &os, vector<double> &values)
+{
+	auto minmax_val = minmax_element(values.begin(), values.end());
+	auto median_val = median(values.begin(), values.end());
+	auto mean_val = mean(values.begin(), values.end());
+	auto stddev_val = stddev(values);
+
+	print_analysis_result(os, "Min", *minmax_val.first);
+	print_analysis_result(os, "Median", median_val);
+	print_analysis_result(os, "Max", *minmax_val.second);
+	print_analysis_result(os, "Mean", mean_val);
+	print_analysis_result(os, "Std Dev", stddev_val);
+}
+
+// e.g. "Could not write the result files of runs 3 7", nothing if every run succeeded
+static void print_failed_runs(ostream &os, const string &what, const vector<char> &succeeded)
+{
+	if (find(succeeded.begin(), succeeded.end(), 0) == succeeded.end()) return;
+
+	os << "Could not write " << what << " of runs";
+	for (size_t r=0; r<succeeded.size(); r+=1)
+	{
+		if (!succeeded[r]) os << ' ' << r;
+	}
+	os << endl;
+}
+
+// ----------------------------------------------------------------------
+struct CRunScheduler::SExperiment
+{
+	SExperiment(): file_found(false), problem(0), improved_version(false) {}
+	~SExperiment() { delete problem; }
+
+	string exp_name;
+	bool file_found;
+	CNSGAIII nsgaiii;
+	BProblem *problem; // 0 if the experiment cannot be carried out
+	bool improved_version;
+	string out_problem_name; // e.g. IMP_DTLZ1(3)
+	shared_ptr<const CFront> PF; // from the cache, empty if there is no PF file
+	shared_ptr<const CPointIndex> PF_index; // from the cache, shared by all the runs
+
+	vector<SIndicators> indicators; // one per run
+	vector< shared_ptr<const CPopulation> > approximations; // one per run, kept until the hypervolumes are computed
+	vector<double> reference; // of the hypervolume: from the PF, or from all the runs without a PF
+	vector<SHypervolume> hypervolumes; // one per run
+	vector<char> results_saved; // one per run, set by the writer (read after writer_.Flush())
+	vector<char> snapshots_saved; // one per run (1 without snapshots)
+};
+// ----------------------------------------------------------------------
+CRunScheduler::CRunScheduler(size_t num_workers, size_t num_runs):
+	num_workers_(num_workers),
+	num_runs_(num_runs)
+{
+	if (num_workers_ == 0) num_workers_ = std::thread::hardware_concurrency();
+	if (num_workers_ == 0) num_workers_ = 1;
+}
+// ----------------------------------------------------------------------
+CRunScheduler::~CRunScheduler()
+{
+	for (size_t i=0; i<experiments_.size(); i+=1)
+	{
+		delete experiments_[i];
+	}
+}
+// ----------------------------------------------------------------------
+void CRunScheduler::Add(const string &exp_name, bool improved_version)
+{
+	SExperiment *exp = new SExperiment;
+	exp->exp_name = exp_name;
+	exp->improved_version = improved_version;
+	experiments_.push_back(exp);
+
+	ifstream exp_ini("Experiments/" + exp_name);
+	if (!exp_ini) return; // reported in Run()
+	exp->file_found = true;
+
+	// ----- Setup the expriment ------
+	SetupExperiment(exp->nsgaiii, &exp->problem, exp_ini);
+	if (!exp->problem) return;
+
+	exp->out_problem_name = (improved_version ? "IMP_" : "") + exp->problem->name();
+	exp->PF = pf_cache_.Get("PF/" + exp->problem->name() + "-PF");
+	exp->PF_index = pf_cache_.GetIndex("PF/" + exp->problem->name() + "-PF");
+	exp->indicators.assign(num_runs_, SIndicators());
+	exp->approximations.assign(num_runs_, shared_ptr<const CPopulation>());
+	exp->hypervolumes.assign(num_runs_, SHypervolume());
+	exp->results_saved.assign(num_runs_, 0);
+	exp->snapshots_saved.assign(num_runs_, 1);
+}
+// ----------------------------------------------------------------------
+void CRunScheduler::RunJob(SExperiment *exp, size_t run)
+{
+	const uint64_t seed = run; // recorded with the IGD value, so that any run can be repeated
+
+	string run_name = "Results/" + exp->nsgaiii.name() + "-" + exp->out_problem_name + "-Run" + IntToStr(run); // e.g. NSGAIII-DTLZ1(3)-Run0
+
+	// --- Solve (with the snapshots of the generations, if the experiment asks for them)
+	unique_ptr<CSnapshotStream> snapshots;
+	if (exp->nsgaiii.snapshot_interval() > 0)
+	{
+		snapshots.reset(new CSnapshotStream);
+		if (!snapshots->Open(run_name + "-Snapshots.bin", exp->nsgaiii.snapshot_interval(), exp->problem->num_objectives(),
+							 exp->nsgaiii.snapshot_variables() ? exp->problem->num_variables() : 0))
+		{
+			snapshots.reset(); // the run goes on without them (reported)
+			exp->snapshots_saved[run] = 0;
+		}
+	}
+	shared_ptr<CPopulation> solutions = make_shared<CPopulation>();
+	exp->nsgaiii.Solve(solutions.get(), *exp->problem, exp->improved_version, seed, 0, snapshots.get());
+	if (snapshots && !snapshots->Close()) exp->snapshots_saved[run] = 0;
+
+	// --- Output the result (in the background; the writer shares the solutions)
+	string logfname = run_name + ".txt";
+	writer_.Post([exp, run, solutions, logfname]() { exp->results_saved[run] = SaveScatterData(logfname, *solutions); });
+
+	// --- Calculate the performance metric (on the objectives in memory, at full precision)
+	exp->indicators[run] = ComputeIndicators(*exp->PF, *exp->PF_index, CFront(*solutions));
+	exp->approximations[run] = solutions;
+}
+// ----------------------------------------------------------------------
+void CRunScheduler::SetReferencePoint(SExperiment *exp) const
+{
+	if (!exp->PF->empty())
+	{
+		exp->reference = HypervolumeReferencePoint(*exp->PF);
+		return;
+	}
+
+	vector<double> all;
+	for (size_t r=0; r<exp->approximations.size(); r+=1)
+	{
+		const CPopulation &pop = *exp->approximations[r];
+		all.insert(all.end(), pop.objs_data(), pop.objs_data() + pop.size()*pop.num_objectives());
+	}
+	size_t M = exp->problem->num_objectives();
+	exp->reference = HypervolumeReferencePoint(CFront(all.data(), all.size()/M, M));
+}
+// ----------------------------------------------------------------------
+void CRunScheduler::Run(ostream &os)
+{
+	vector< pair<SExperiment *, size_t> > jobs; // (experiment, run)
+	for (size_t i=0; i<experiments_.size(); i+=1)
+	{
+		if (!experiments_[i]->problem) continue;
+
+		for (size_t r=0; r<num_runs_; r+=1)
+		{
+			jobs.push_back(make_pair(experiments_[i], r));
+		}
+	}
+
+	// every worker takes the next job until none is left
+	atomic<size_t> next_job(0);
+	CThreadPool pool(std::min(num_workers_, std::max<size_t>(jobs.size(), 1)));
+	pool.ParallelFor(pool.size(), [&](size_t, size_t, size_t)
+	{
+		for (size_t j=next_job++; j<jobs.size(); j=next_job++)
+		{
+			RunJob(jobs[j].first, jobs[j].second);
+		}
+	});
+
+	// the hypervolumes need the reference point of all the runs of an experiment
+	for (size_t i=0; i<experiments_.size(); i+=1)
+	{
+		if (experiments_[i]->problem) SetReferencePoint(experiments_[i]);
+	}
+	next_job = 0;
+	pool.ParallelFor(pool.size(), [&](size_t, size_t, size_t)
+	{
+		for (size_t j=next_job++; j<jobs.size(); j=next_job++)
+		{
+			SExperiment *exp = jobs[j].first;
+			size_t run = jobs[j].second;
+			exp->hypervolumes[run] = Hypervolume(CFront(*exp->approximations[run]), exp->reference, hvAuto, 0, HypervolumeDefaultSamples, run);
+			exp->approximations[run].reset();
+		}
+	});
+	writer_.Flush(); // the result files are complete before the report
+
+	for (size_t i=0; i<experiments_.size(); i+=1)
+	{
+		Report(os, *experiments_[i]);
+		delete experiments_[i];
+	}
+	experiments_.clear();
+}
+// ----------------------------------------------------------------------
+void CRunScheduler::Report(ostream &os, const SExperiment &exp) const
+{
+	if (!exp.file_found) { os << exp.exp_name << " file does not exist." << endl; return; }
+	if (!exp.problem) { os << exp.exp_name << " specifies an unknown problem." << endl; return; }
+
+	string prefix = exp.nsgaiii.name() + "-" + exp.out_problem_name;
+	ofstream IGD_results(prefix + "-IGD.txt"); // output file for IGD values (and seeds) per run
+	ofstream all_results(prefix + "-Indicators.txt"); // IGD, IGD+, GD, GD+, HV (and seeds) per run
+	all_results << "IGD\tIGD+\tGD\tGD+\tHV\tHV.lower\tHV.upper\tseed" << endl;
+
+	os << "Solving " << exp.problem->name() << (exp.improved_version ? "(w/ improved algo)" : "") << endl;
+	vector<double> igd_values, hv_values;
+	double hv_half_width = 0; // of the confidence intervals, on average
+	for (size_t r=0; r<exp.indicators.size(); r+=1)
+	{
+		const SIndicators &ind = exp.indicators[r];
+		const SHypervolume &hv = exp.hypervolumes[r];
+		#if VERBOSE_RUNS
+		os << "...Run: " << r << " (seed " << r << ")" << endl;
+		#endif
+		os << ind.IGD << endl;
+		IGD_results << ind.IGD << '\t' << r << endl;
+		all_results << ind.IGD << '\t' << ind.IGD_plus << '\t' << ind.GD << '\t' << ind.GD_plus << '\t'
+					<< hv.value << '\t' << hv.lower << '\t' << hv.upper << '\t' << r << endl;
+		igd_values.push_back(ind.IGD);
+		hv_values.push_back(hv.value);
+		hv_half_width += (hv.upper - hv.lower)/2/exp.hypervolumes.size();
+	}
+	print_summary(os, igd_values);
+	print_failed_runs(os, "the result files (Results/" + prefix + "-Run<r>.txt)", exp.results_saved);
+	print_failed_runs(os, "the snapshot logs (Results/" + prefix + "-Run<r>-Snapshots.bin)", exp.snapshots_saved);
+
+	if (exp.reference.empty()) return;
+	os << "Hypervolume (";
+	if (exp.reference.size() <= HypervolumeExactMaxObjectives) os << "exact";
+	else os << "Monte Carlo, " << HypervolumeDefaultSamples << " samples, 95% CI +- " << hv_half_width;
+	os << "; reference point " << (exp.PF->empty() ? "from the runs" : "from the PF") << ":";
+	for (size_t k=0; k<exp.reference.size(); k+=1) os << ' ' << exp.reference[k];
+	os << ")" << endl;
+	print_summary(os, hv_values);
+}
+// ----------------------------------------------------------------------
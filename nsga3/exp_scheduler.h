@@ -0,0 +1,71 @@
+#ifndef SCHEDULER__
+#define SCHEDULER__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "exp_front.h"
+#include "aux_async_writer.h"
+
+// ----------------------------------------------------------------------------------
+//		CRunScheduler
+//
+// Carries out the independent runs of a list of experiments on a pool of workers.
+// Every (experiment, run) pair is a job; the workers take the next job from a shared
+// counter, so cheap and expensive experiments are balanced over all the workers.
+//
+// Run r of an experiment always uses seed r and writes its own result file, so the
+// results do not depend on the number of workers or on the order in which the jobs
+// finish. The report (the IGD value of each run and the statistics of each experiment)
+// is written in the order in which the experiments were added, after all the jobs.
+//
+// The hypervolumes are computed in a second pass over the same jobs, once the reference
+// point of each experiment is known: it is taken from the PF, or from all the runs of the
+// experiment when there is no PF file (see HypervolumeReferencePoint()).
+//
+// The PFs and their nearest neighbour indexes are built once per scheduler (see
+// CFrontCache), so the runs and the experiments on the same problem share them.
+//
+// The indicators are computed from the solutions in memory. The result files are
+// written by a background writer (CAsyncWriter) and are complete when Run() returns.
+// An experiment file with snapshot.interval = k also gets a snapshot log of every k-th
+// generation per run (Results/...-Run<r>-Snapshots.bin, see CSnapshotStream).
+// The runs whose result file or snapshot log could not be written are listed in the
+// report of their experiment.
+//
+// Note. The workers multiply with the threads of each run (thread.number in the
+// experiment file), so one of the two is usually left at 1.
+// ----------------------------------------------------------------------------------
+class CRunScheduler
+{
+public:
+	explicit CRunScheduler(std::size_t num_workers = 0, std::size_t num_runs = 20); // 0: one worker per hardware thread
+	~CRunScheduler();
+
+	std::size_t num_workers() const { return num_workers_; }
+	bool empty() const { return experiments_.empty(); }
+
+	// exp_name: the experiment file in Experiments/ (IMP_ prefix removed)
+	void Add(const std::string &exp_name, bool improved_version);
+
+	// carry out all the experiments added so far, report them, and forget them
+	void Run(std::ostream &os);
+
+private:
+	CRunScheduler(const CRunScheduler &);
+	CRunScheduler & operator=(const CRunScheduler &);
+
+	struct SExperiment;
+	void RunJob(SExperiment *exp, std::size_t run);
+	void SetReferencePoint(SExperiment *exp) const;
+	void Report(std::ostream &os, const SExperiment &exp) const;
+
+	std::size_t num_workers_, num_runs_;
+	std::vector<SExperiment *> experiments_;
+	CFrontCache pf_cache_;
+	CAsyncWriter writer_; // of the result files
+};
+
+#endif
@@ -0,0 +1,205 @@
+#include "exp_snapshot.h"
+#include "alg_population.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+static const char SnapshotMagic[8] = { 'N', 'S', 'G', 'A', 'S', 'N', 'A', 'P' },
+				  SnapshotIndexMagic[8] = { 'N', 'S', 'G', 'A', 'S', 'I', 'D', 'X' },
+				  SnapshotEndMagic[8] = { 'N', 'S', 'G', 'A', 'S', 'E', 'N', 'D' };
+
+// ----------------------------------------------------------------------
+CSnapshotStream::CSnapshotStream():
+	file_(0),
+	interval_(1),
+	num_objs_(0),
+	num_vars_(0),
+	offset_(0),
+	failed_(false)
+{
+}
+// ----------------------------------------------------------------------
+CSnapshotStream::~CSnapshotStream()
+{
+	Close();
+}
+// ----------------------------------------------------------------------
+bool CSnapshotStream::Open(const string &fname, size_t interval, size_t num_objectives, size_t num_variables, size_t queue_capacity)
+{
+	Close();
+
+	file_ = fopen(fname.c_str(), "wb");
+	if (!file_) return false;
+
+	interval_ = std::max<size_t>(interval, 1);
+	num_objs_ = num_objectives;
+	num_vars_ = num_variables;
+	failed_ = false;
+	index_.clear();
+
+	buffers_.resize(std::max<size_t>(queue_capacity, 1));
+	free_.clear();
+	for (size_t i=0; i<buffers_.size(); i+=1) free_.push_back(&buffers_[i]);
+
+	uint64_t header[2] = { num_objs_, num_vars_ };
+	failed_ = fwrite(SnapshotMagic, sizeof(SnapshotMagic), 1, file_) != 1 ||
+			  fwrite(header, sizeof(header), 1, file_) != 1;
+	offset_ = sizeof(SnapshotMagic) + sizeof(header);
+
+	writer_.reset(new CAsyncWriter);
+	return !failed_;
+}
+// ----------------------------------------------------------------------
+void CSnapshotStream::Push(size_t generation, const CPopulation &pop)
+{
+	if (!file_) return;
+
+	SBuffer *buffer = 0;
+	{
+		unique_lock<mutex> lock(free_mutex_);
+		released_.wait(lock, [this] { return !free_.empty(); });
+		buffer = free_.back();
+		free_.pop_back();
+	}
+
+	const size_t n = pop.size(), num_vars = std::min(num_vars_, pop.num_variables()), columns = num_vars_ + num_objs_;
+	buffer->generation = generation;
+	buffer->rows = n;
+	buffer->values.resize(n*columns); // keeps its capacity
+	for (size_t i=0; i<n; i+=1)
+	{
+		double *row = &buffer->values[i*columns];
+		std::fill_n(row, num_vars_, 0.0);
+		std::copy_n(pop.vars_data() + i*pop.num_variables(), num_vars, row);
+		std::copy_n(pop.objs_data() + i*pop.num_objectives(), std::min(num_objs_, pop.num_objectives()), row + num_vars_);
+	}
+
+	writer_->Post([this, buffer]() { WriteRecord(buffer); });
+}
+// ----------------------------------------------------------------------
+void CSnapshotStream::WriteRecord(SBuffer *buffer)
+{
+	uint64_t header[2] = { buffer->generation, buffer->rows };
+	size_t size = buffer->values.size();
+	if (fwrite(header, sizeof(header), 1, file_) != 1 ||
+		fwrite(buffer->values.data(), sizeof(double), size, file_) != size) failed_ = true;
+
+	index_.push_back(buffer->generation);
+	index_.push_back(buffer->rows);
+	index_.push_back(offset_);
+	offset_ += sizeof(header) + size*sizeof(double);
+
+	{
+		lock_guard<mutex> lock(free_mutex_);
+		free_.push_back(buffer);
+	}
+	released_.notify_one();
+}
+// ----------------------------------------------------------------------
+bool CSnapshotStream::Close()
+{
+	if (!file_) return !failed_;
+
+	writer_.reset(); // after the records posted so far
+
+	uint64_t count = index_.size()/3, index_offset = offset_;
+	if (fwrite(SnapshotIndexMagic, sizeof(SnapshotIndexMagic), 1, file_) != 1 ||
+		fwrite(&count, sizeof(count), 1, file_) != 1 ||
+		fwrite(index_.data(), sizeof(uint64_t), index_.size(), file_) != index_.size() ||
+		fwrite(&index_offset, sizeof(index_offset), 1, file_) != 1 ||
+		fwrite(SnapshotEndMagic, sizeof(SnapshotEndMagic), 1, file_) != 1) failed_ = true;
+
+	if (fclose(file_) != 0) failed_ = true;
+	file_ = 0;
+	return !failed_;
+}
+// ----------------------------------------------------------------------
+bool CSnapshotReader::Open(const string &fname)
+{
+	fname_ = fname;
+	records_.clear();
+	num_objs_ = num_vars_ = 0;
+
+	// The sizes in a log come from the file, and a log of a run that did not finish
+	// may be damaged: every size is checked against the file size before it is used.
+	ifstream ifile(fname, ios::binary);
+	char magic[8];
+	uint64_t header[2];
+	if (!ifile.read(magic, sizeof(magic)) || memcmp(magic, SnapshotMagic, sizeof(magic)) != 0 ||
+		!ifile.read(reinterpret_cast<char *>(header), sizeof(header))) return false;
+
+	const uint64_t columns = header[0] + header[1];
+	if (columns == 0 || columns < header[0] || columns > UINT64_MAX/sizeof(double)) return false; // a damaged header
+	num_objs_ = header[0];
+	num_vars_ = header[1];
+	const uint64_t first_record = sizeof(magic) + sizeof(header), row_size = columns*sizeof(double);
+
+	ifile.seekg(0, ios::end);
+	const streamoff end = ifile.tellg();
+	if (end < 0) return false;
+	const uint64_t file_size = end;
+
+	// the index, if the log was closed
+	uint64_t trailer[2] = {};
+	if (file_size >= first_record + sizeof(trailer))
+	{
+		ifile.seekg(file_size - sizeof(trailer));
+		ifile.read(reinterpret_cast<char *>(trailer), sizeof(trailer));
+	}
+	const uint64_t index_offset = trailer[0], index_overhead = 2*sizeof(uint64_t) + sizeof(trailer); // magic and count, trailer
+	if (ifile && memcmp(&trailer[1], SnapshotEndMagic, sizeof(magic)) == 0 &&
+		index_offset >= first_record && index_offset <= file_size - index_overhead)
+	{
+		uint64_t count = 0;
+		const uint64_t index_size = file_size - index_overhead - index_offset;
+		ifile.seekg(index_offset);
+		if (ifile.read(magic, sizeof(magic)) && memcmp(magic, SnapshotIndexMagic, sizeof(magic)) == 0 &&
+			ifile.read(reinterpret_cast<char *>(&count), sizeof(count)) &&
+			index_size % sizeof(SRecord) == 0 && count == index_size/sizeof(SRecord))
+		{
+			records_.resize(count);
+			bool valid = bool(ifile.read(reinterpret_cast<char *>(records_.data()), count*sizeof(SRecord)));
+			for (size_t i=0; i<records_.size() && valid; i+=1)
+			{
+				const SRecord &record = records_[i];
+				valid = record.offset >= first_record && record.offset <= index_offset - 2*sizeof(uint64_t) &&
+						record.rows <= (index_offset - record.offset - 2*sizeof(uint64_t))/row_size;
+			}
+			if (valid) return true;
+		}
+		records_.clear(); // a damaged index: the records are scanned
+	}
+
+	// otherwise the complete records from the beginning
+	ifile.clear();
+	SRecord record;
+	for (record.offset = first_record; record.offset + 2*sizeof(uint64_t) <= file_size; )
+	{
+		ifile.seekg(record.offset);
+		uint64_t record_header[2];
+		if (!ifile.read(reinterpret_cast<char *>(record_header), sizeof(record_header))) break;
+		if (memcmp(record_header, SnapshotIndexMagic, sizeof(magic)) == 0) break; // an incomplete index
+		record.generation = record_header[0];
+		record.rows = record_header[1];
+
+		const uint64_t data_offset = record.offset + sizeof(record_header);
+		if (record.rows > (file_size - data_offset)/row_size) break; // cut off or damaged
+		records_.push_back(record);
+		record.offset = data_offset + record.rows*row_size;
+	}
+	return true;
+}
+// ----------------------------------------------------------------------
+bool CSnapshotReader::Read(size_t i, vector<double> *values) const
+{
+	const SRecord &record = records_[i];
+	values->resize(record.rows*(num_objs_ + num_vars_));
+
+	ifstream ifile(fname_, ios::binary);
+	ifile.seekg(record.offset + 2*sizeof(uint64_t));
+	return bool(ifile.read(reinterpret_cast<char *>(values->data()), values->size()*sizeof(double)));
+}
+// ----------------------------------------------------------------------
@@ -0,0 +1,115 @@
+#ifndef SNAPSHOT__
+#define SNAPSHOT__
+
+#include "alg_snapshot_sink.h"
+#include "aux_async_writer.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------------
+//		Snapshot logs
+//
+// The populations of every k-th generation of a run, appended to one binary file:
+//
+//   header : the magic "NSGASNAP", the number of objectives and the number of
+//            variables stored per individual (0: objectives only)
+//   record : the generation and the number of rows, then the rows (the variables,
+//            if any, then the objectives of each individual)
+//   index  : written by Close(): the magic "NSGASIDX", the number of records and
+//            (generation, rows, offset) per record, then the offset of the index
+//            and the magic "NSGASEND" at the end of the file
+//
+// All the numbers are uint64 and the values doubles, in the byte order of the
+// machine. A log without an index (a run that did not finish) is read by scanning
+// its records.
+// ----------------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------------
+//		CSnapshotStream
+//
+// Push() copies the matrices of a population into a free buffer and returns; the
+// records are written by a background thread. There are queue_capacity buffers, so
+// at most that many snapshots wait for the disk: when all of them do, Push() waits
+// for one to be written. The buffers are reused, so a run does not allocate for its
+// snapshots once every buffer has held one. The background thread only runs while the
+// log is open.
+// ----------------------------------------------------------------------------------
+class CSnapshotStream : public BSnapshotSink
+{
+public:
+	CSnapshotStream();
+	~CSnapshotStream(); // closes the log
+
+	// interval: the generations that are multiples of it are taken (see Wants())
+	bool Open(const std::string &fname, std::size_t interval, std::size_t num_objectives,
+			  std::size_t num_variables = 0, std::size_t queue_capacity = 4);
+	bool Close(); // writes the index; false if anything could not be written
+
+	bool is_open() const { return file_ != 0; }
+	virtual bool Wants(std::size_t generation) const { return file_ != 0 && generation % interval_ == 0; }
+	virtual void Push(std::size_t generation, const CPopulation &pop);
+
+private:
+	CSnapshotStream(const CSnapshotStream &);
+	CSnapshotStream & operator=(const CSnapshotStream &);
+
+	struct SBuffer
+	{
+		std::uint64_t generation, rows;
+		std::vector<double> values;
+	};
+	void WriteRecord(SBuffer *buffer); // on the writer thread
+
+	std::FILE *file_;
+	std::size_t interval_, num_objs_, num_vars_;
+	std::uint64_t offset_; // of the next record
+	bool failed_;
+
+	std::vector<SBuffer> buffers_;
+	std::vector<SBuffer *> free_;
+	std::mutex free_mutex_;
+	std::condition_variable released_;
+
+	std::vector<std::uint64_t> index_; // (generation, rows, offset) per record
+
+	std::unique_ptr<CAsyncWriter> writer_; // while the log is open
+};
+
+// ----------------------------------------------------------------------------------
+//		CSnapshotReader: the records of a snapshot log, for offline analysis
+// ----------------------------------------------------------------------------------
+class CSnapshotReader
+{
+public:
+	CSnapshotReader(): num_objs_(0), num_vars_(0) {}
+
+	// false if the file is not a snapshot log; a damaged index or record is not trusted,
+	// so the records read are the complete ones before it
+	bool Open(const std::string &fname);
+
+	std::size_t size() const { return records_.size(); }
+	std::size_t num_objectives() const { return num_objs_; }
+	std::size_t num_variables() const { return num_vars_; }
+
+	std::size_t generation(std::size_t i) const { return records_[i].generation; }
+	std::size_t rows(std::size_t i) const { return records_[i].rows; }
+
+	// rows(i) rows of num_variables()+num_objectives() values
+	bool Read(std::size_t i, std::vector<double> *values) const;
+
+private:
+	struct SRecord { std::uint64_t generation, rows, offset; };
+
+	std::string fname_;
+	std::size_t num_objs_, num_vars_;
+	std::vector<SRecord> records_;
+};
+
+#endif
@@ -1,38 +1,181 @@
 
 #include "log.h"
 #include "alg_population.h"
+#include "exp_front.h"
 #include "gnuplot_interface.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <sstream>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 using namespace std;
 
+const char BinaryColumnsMagic[8] = { 'N', 'S', 'G', 'A', 'C', 'O', 'L', 'S' };
 
+// ----------------------------------------------------------------------
+// 17 significant digits always read back to the same double. (Looking for
+// fewer digits that also do costs a strtod() per value and does not pay
+// off: most objective values need 16 or 17 digits anyway.)
+// ----------------------------------------------------------------------
+static int FormatDouble(char *str, size_t size, double value)
+{
+	return snprintf(str, size, "%.17g", value);
+}
+// ----------------------------------------------------------------------
+const size_t CResultWriter::BufferSize;
 
-bool SaveScatterData(const std::string &fname, const CPopulation &pop, LogDetails details, ios_base::openmode mode)
+CResultWriter::CResultWriter():
+	file_(0),
+	gz_(0),
+	format_(lfText),
+	used_(0),
+	failed_(false)
 {
-	ofstream ofile(fname.c_str(), mode);
-	if (!ofile) return false;
+}
+// ----------------------------------------------------------------------
+CResultWriter::~CResultWriter()
+{
+	Close();
+}
+// ----------------------------------------------------------------------
+bool CResultWriter::CompressionAvailable()
+{
+#ifdef HAVE_ZLIB
+	return true;
+#else
+	return false;
+#endif
+}
+// ----------------------------------------------------------------------
+bool CResultWriter::Open(const string &fname, LogFormat format, bool compress, ios_base::openmode mode)
+{
+	Close();
+
+	bool append = (mode & ios_base::app) != 0;
+	if (compress)
+	{
+#ifdef HAVE_ZLIB
+		gz_ = gzopen(fname.c_str(), append ? "ab1" : "wb1");
+#endif
+		if (!gz_) return false;
+	}
+	else
+	{
+		file_ = fopen(fname.c_str(), append ? "ab" : "wb");
+		if (!file_) return false;
+	}
+
+	format_ = format;
+	buffer_.resize(BufferSize);
+	used_ = 0;
+	failed_ = false;
+	return true;
+}
+// ----------------------------------------------------------------------
+bool CResultWriter::Close()
+{
+	if (!is_open()) return !failed_;
+
+	FlushBuffer();
+	if (file_ && fclose(file_) != 0) failed_ = true;
+#ifdef HAVE_ZLIB
+	if (gz_ && gzclose(static_cast<gzFile>(gz_)) != Z_OK) failed_ = true;
+#endif
+	file_ = 0;
+	gz_ = 0;
+	return !failed_;
+}
+// ----------------------------------------------------------------------
+void CResultWriter::FlushBuffer()
+{
+	if (used_ == 0) return;
 
-	for (size_t i=0; i<pop.size(); i+=1)
+	if (file_) failed_ = failed_ || fwrite(buffer_.data(), 1, used_, file_) != used_;
+#ifdef HAVE_ZLIB
+	if (gz_) failed_ = failed_ || gzwrite(static_cast<gzFile>(gz_), buffer_.data(), (unsigned)used_) != (int)used_;
+#endif
+	used_ = 0;
+}
+// ----------------------------------------------------------------------
+void CResultWriter::Put(const void *data, size_t size)
+{
+	const char *p = static_cast<const char *>(data);
+	while (size > 0)
 	{
+		if (used_ == BufferSize) FlushBuffer();
+
+		size_t n = std::min(size, BufferSize - used_);
+		memcpy(&buffer_[used_], p, n);
+		used_ += n;
+		p += n;
+		size -= n;
+	}
+}
+// ----------------------------------------------------------------------
+void CResultWriter::PutValue(double value)
+{
+	const size_t MaxLength = 32; // e.g. -1.2345678901234567e-308 and a space
+	if (used_ + MaxLength > BufferSize) FlushBuffer();
+
+	used_ += FormatDouble(&buffer_[used_], MaxLength, value);
+	buffer_[used_++] = ' ';
+}
+// ----------------------------------------------------------------------
+bool CResultWriter::Write(const CPopulation &pop, LogDetails details)
+{
+	if (!is_open()) return false;
+
+	const size_t num_vars = (details == ldAll ? pop.num_variables() : 0),
+				 num_objs = pop.num_objectives(),
+				 n = pop.size();
 
-		if (details == ldAll)
+	if (format_ == lfText)
+	{
+		for (size_t i=0; i<n; i+=1)
 		{
-			for (size_t j=0; j<pop[i].vars().size(); j+=1)
-			{
-				ofile << pop[i].vars()[j] << ' ';
-			}
+			for (size_t j=0; j<num_vars; j+=1) PutValue(pop.vars_data()[i*num_vars + j]);
+			for (size_t f=0; f<num_objs; f+=1) PutValue(pop.objs_data()[i*num_objs + f]);
+			Put("\n", 1);
 		}
+		Put("\n", 1);
+		return !failed_;
+	}
 
-		for (size_t f=0; f<pop[i].objs().size(); f+=1)
+	uint64_t header[2] = { num_vars + num_objs, n };
+	Put(format_ == lfBinary ? BinaryFrontMagic : BinaryColumnsMagic, sizeof(BinaryFrontMagic));
+	Put(header, sizeof(header));
+
+	if (format_ == lfBinary)
+	{
+		for (size_t i=0; i<n; i+=1)
 		{
-			ofile << pop[i].objs()[f] << ' ';
+			Put(pop.vars_data() + i*num_vars, num_vars*sizeof(double));
+			Put(pop.objs_data() + i*num_objs, num_objs*sizeof(double));
 		}
-		ofile << endl;
 	}
-	ofile << endl;
-	return true;
+	else // column by column
+	{
+		for (size_t j=0; j<num_vars; j+=1)
+		{
+			for (size_t i=0; i<n; i+=1) Put(pop.vars_data() + i*num_vars + j, sizeof(double));
+		}
+		for (size_t f=0; f<num_objs; f+=1)
+		{
+			for (size_t i=0; i<n; i+=1) Put(pop.objs_data() + i*num_objs + f, sizeof(double));
+		}
+	}
+	return !failed_;
+}
+// ----------------------------------------------------------------------
+bool SaveScatterData(const std::string &fname, const CPopulation &pop, LogDetails details, ios_base::openmode mode)
+{
+	CResultWriter writer;
+	return writer.Open(fname, lfText, false, mode) && writer.Write(pop, details) && writer.Close();
 }
 // ----------------------------------------------------------------------
 bool SaveValuePathData(const std::string &fname, const CPopulation &pop, ios_base::openmode mode)
@@ -40,18 +183,21 @@ bool SaveValuePathData(const std::string &fname, const CPopulation &pop, ios_bas
 	ofstream ofile(fname.c_str(), mode);
 	if (!ofile) return false;
 
+	string text;
+	char value[32];
 	for (size_t f=0; f<pop[0].objs().size(); f+=1)
 	{
-		ofile << f+1 << ' ';
+		text += to_string(f+1) + ' ';
 		for (size_t i=0; i<pop.size(); i+=1)
 		{
-			ofile << pop[i].objs()[f] << ' ';
+			text.append(value, FormatDouble(value, sizeof(value), pop[i].objs()[f]));
+			text += ' ';
 		}
-		ofile << endl;
+		text += '\n';
 	}
-	ofile << endl;
+	text += '\n';
 
-	return true;
+	return bool(ofile.write(text.data(), text.size()));
 }
 // ----------------------------------------------------------------------
 bool ShowPopulation(Gnuplot &gplot, const CPopulation &pop, const std::string &legend)
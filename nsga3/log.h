@@ -1,15 +1,71 @@
 #ifndef LOG__
 #define LOG__
 
+#include <cstddef>
+#include <cstdio>
 #include <string>
 #include <iostream>
+#include <vector>
 
 class CPopulation;
 class Gnuplot;
 
 enum LogDetails { ldObjective, ldAll };
+enum LogFormat { lfText, lfBinary, lfBinaryColumns };
 
-// Save a population into the designated file.
+// ----------------------------------------------------------------------
+//		CResultWriter
+//
+// Writes populations into a file, one block per Write() (e.g. one per
+// generation), through a large buffer.
+//
+// lfText: one individual per line and an empty line after each block, as
+// SaveScatterData(). Every value is written with 17 significant digits,
+// so it reads back to the same double.
+//
+// lfBinary: each block is the header of a binary front file (see CFront)
+// followed by its rows, so a file of one block is a binary front file.
+// lfBinaryColumns: the same with BinaryColumnsMagic and the values stored
+// column by column, which compresses better.
+//
+// Compression (gzip, level 1) needs zlib: build with HAVE_ZLIB defined and
+// link with -lz. Otherwise Open() fails when asked to compress.
+// ----------------------------------------------------------------------
+extern const char BinaryColumnsMagic[8];
+
+class CResultWriter
+{
+public:
+	CResultWriter();
+	~CResultWriter(); // closes the file
+
+	bool Open(const std::string &fname, LogFormat format = lfText, bool compress = false,
+			  std::ios_base::openmode mode = std::ios_base::out); // out or app
+	bool Write(const CPopulation &pop, LogDetails details = ldObjective);
+	bool Close(); // false if anything could not be written
+
+	bool is_open() const { return file_ != 0 || gz_ != 0; }
+	static bool CompressionAvailable();
+
+private:
+	CResultWriter(const CResultWriter &);
+	CResultWriter & operator=(const CResultWriter &);
+
+	static const std::size_t BufferSize = 1 << 20;
+
+	void Put(const void *data, std::size_t size);
+	void PutValue(double value); // as text
+	void FlushBuffer();
+
+	std::FILE *file_;
+	void *gz_; // gzFile
+	LogFormat format_;
+	std::vector<char> buffer_;
+	std::size_t used_;
+	bool failed_;
+};
+
+// Save a population into the designated file (text, see CResultWriter).
 bool SaveScatterData(const std::string &fname, const CPopulation &pop, 
 					 LogDetails details = ldObjective,
 					 std::ios_base::openmode mode = std::ios_base::out);
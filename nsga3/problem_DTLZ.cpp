@@ -1,21 +1,24 @@
 
 #include "problem_DTLZ.h"
-#include "alg_individual.h"
+#include "alg_population.h"
 #include "aux_math.h"
+#include "aux_vector_math.h"
 #include "aux_misc.h"
 
 #include <cmath>
 #include <vector>
+#include <algorithm>
 
 using std::size_t;
 using std::cos;
+using std::sin;
 
 // ----------------------------------------------------------------------
 //		CProblemDTLZ
 // ----------------------------------------------------------------------
 
 CProblemDTLZ::CProblemDTLZ(size_t M, size_t k, const std::string &name):
-	BProblem(name + "(" + IntToStr(M) + ")"), 
+	BRowProblem(name + "(" + IntToStr(M) + ")"), 
 	M_(M), 
 	k_(k)
 {
@@ -25,120 +28,222 @@ CProblemDTLZ::CProblemDTLZ(size_t M, size_t k, const std::string &name):
 
 
 // ----------------------------------------------------------------------
-//		CProblemDTLZ1
+//		Helpers of DTLZ1-4
+//
+// The objectives are computed with prefix products, i.e. O(M) instead of
+// O(M^2) per individual: f[M-1-j] is the product of the first j position
+// factors times the "closing" factor of position j. The multiplications
+// are done in the same order as in the definition of the problems.
+//
+// The batch versions compute the trigonometric functions of a whole
+// block of individuals with MathAux::SinCos() and MathAux::Cos(). The
+// blocks are sized to fit buffers on the stack, so they do not allocate.
+// A row that does not fit (thousands of objectives or position-related
+// variables) is left to EvaluateRow().
 // ----------------------------------------------------------------------
-bool CProblemDTLZ1::Evaluate(CIndividual *indv) const
-{
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != M_ + k_ - 1) return false; // #variables does not match
+const size_t BatchScratch = 1024; // doubles per buffer
 
+static size_t BlockRows(size_t per_row) // 0 if a single row does not fit
+{
+	return per_row == 0 ? BatchScratch : BatchScratch/per_row;
+}
+// ----------------------------------------------------------------------
+static inline double Angle(double x, double alpha) // theta in DTLZ2-4
+{
+	return (alpha == 1 ? x : std::pow(x, alpha))*MathAux::PI/2;
+}
+// ----------------------------------------------------------------------
+static double SphereG(const double *x, size_t M, size_t k) // DTLZ2 and DTLZ4
+{
 	double g = 0;
-	for (size_t i = M_-1; i < x.size(); i += 1)
+	for (size_t i = M-1; i < M+k-1; i += 1)
 	{
-		g += MathAux::square(x[i]-0.5) - cos(20*MathAux::PI*(x[i]-0.5));
+		g += MathAux::square(x[i]-0.5);
 	}
-	g = (k_ + g)*100;
-
-
-	f.resize(M_, 0);
-	for (size_t m = 0; m < M_; m += 1)
+	return g;
+}
+// ----------------------------------------------------------------------
+// RastriginG(): g of DTLZ1 and DTLZ3. cosines[i] = cos(20*pi*(x[M-1+i]-0.5))
+// if given, otherwise they are computed here.
+// ----------------------------------------------------------------------
+static double RastriginG(const double *x, size_t M, size_t k, const double *cosines)
+{
+	double g = 0;
+	for (size_t i = 0; i < k; i += 1)
 	{
-		double product = 0.5*(1+g);
-		size_t i = 0;
-		for (; M_ >= 2+m && i <= M_-2-m; i += 1)
+		double xi = x[M-1+i];
+		g += MathAux::square(xi-0.5) - (cosines ? cosines[i] : cos(20*MathAux::PI*(xi-0.5)));
+	}
+	return (k + g)*100;
+}
+// ----------------------------------------------------------------------
+static void RastriginCosines(const double *x, size_t n, size_t M, size_t k, double *cosines) // n rows, k cosines per row
+{
+	const size_t nv = M+k-1;
+	for (size_t r=0; r<n; r+=1)
+	{
+		for (size_t i=0; i<k; i+=1)
 		{
-			product *= x[i];
+			cosines[r*k+i] = 20*MathAux::PI*(x[r*nv+M-1+i]-0.5);
 		}
-		if (m > 0)
+	}
+	MathAux::Cos(cosines, n*k, cosines);
+}
+// ----------------------------------------------------------------------
+static void LinearShape(double scale, const double *x, size_t M, double *f) // DTLZ1
+{
+	double product = scale;
+	for (size_t j=0; j+1<M; j+=1)
+	{
+		f[M-1-j] = product*(1 - x[j]);
+		product *= x[j];
+	}
+	f[0] = product;
+}
+// ----------------------------------------------------------------------
+static void SphericalShape(double scale, const double *x, size_t M, double alpha, double *f) // DTLZ2-4
+{
+	double product = scale;
+	for (size_t j=0; j+1<M; j+=1)
+	{
+		double theta = Angle(x[j], alpha);
+		f[M-1-j] = product*sin(theta);
+		product *= cos(theta);
+	}
+	f[0] = product;
+}
+// ----------------------------------------------------------------------
+static void SphericalShapeSinCos(double scale, const double *s, const double *c, size_t M, double *f)
+{
+	double product = scale;
+	for (size_t j=0; j+1<M; j+=1)
+	{
+		f[M-1-j] = product*s[j];
+		product *= c[j];
+	}
+	f[0] = product;
+}
+// ----------------------------------------------------------------------
+static void AngleSinCos(const double *x, size_t n, size_t M, size_t k, double alpha, double *s, double *c) // n rows, M-1 angles per row
+{
+	const size_t nv = M+k-1;
+	for (size_t r=0; r<n; r+=1)
+	{
+		for (size_t j=0; j+1<M; j+=1)
 		{
-			product *= (1 - x[i]);
+			c[r*(M-1)+j] = Angle(x[r*nv+j], alpha);
 		}
-		f[m] = product;
 	}
+	MathAux::SinCos(c, n*(M-1), s, c);
+}
+// ----------------------------------------------------------------------
+// SphericalBatch(): DTLZ2-4 for n rows; g of DTLZ3 is Rastrigin-like.
+// Return false if a row does not fit in the buffers.
+// ----------------------------------------------------------------------
+static bool SphericalBatch(const double *x, double *f, size_t n, size_t M, size_t k, double alpha, bool rastrigin)
+{
+	const size_t block = BlockRows(std::max(M-1, rastrigin ? k : 0));
+	if (block == 0) return false;
 
-	return true;
-
-}// bool CProblemDTLZ1::Evaluate(CIndividual *indv) const
-
+	double s[BatchScratch], c[BatchScratch], cosines[BatchScratch];
+	const size_t nv = M+k-1;
+	for (size_t first=0; first<n; first+=block)
+	{
+		const size_t rows = std::min(block, n-first);
+		const double *xb = x+first*nv;
+		AngleSinCos(xb, rows, M, k, alpha, s, c);
+		if (rastrigin) RastriginCosines(xb, rows, M, k, cosines);
 
+		for (size_t r=0; r<rows; r+=1)
+		{
+			double g = rastrigin ? RastriginG(xb+r*nv, M, k, cosines+r*k) : SphereG(xb+r*nv, M, k);
+			SphericalShapeSinCos(1+g, s+r*(M-1), c+r*(M-1), M, f+(first+r)*M);
+		}
+	}
+	return true;
+}
 
 
 // ----------------------------------------------------------------------
-//		CProblemDTLZ2
+//		CProblemDTLZ1
 // ----------------------------------------------------------------------
-bool CProblemDTLZ2::Evaluate(CIndividual *indv) const
+bool CProblemDTLZ1::EvaluateBatch(CPopulation *pop, size_t begin, size_t end) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
+	const double *x = 0;
+	double *f = 0;
+	if (!BatchRows(pop, begin, &x, &f)) return false;
 
-	if (x.size() != M_ + k_ - 1) return false; // #variables does not match
+	const size_t n = end-begin, nv = M_+k_-1, block = BlockRows(k_);
+	if (block == 0) return BRowProblem::EvaluateBatch(pop, begin, end);
 
-	double g = 0;
-	for (size_t i = M_-1; i < x.size(); i += 1)
+	double cosines[BatchScratch];
+	for (size_t first=0; first<n; first+=block)
 	{
-		g += MathAux::square(x[i]-0.5);
-	}
+		const size_t rows = std::min(block, n-first);
+		RastriginCosines(x+first*nv, rows, M_, k_, cosines);
 
-	f.resize(M_, 0);
-	for (size_t m = 0; m < M_; m += 1)
-	{
-		double product = (1+g);
-		size_t i=0;
-		for (; i+m<=M_-2; i+=1)
+		for (size_t r=0; r<rows; r+=1)
 		{
-			product *= cos(x[i]*MathAux::PI/2);
+			double g = RastriginG(x+(first+r)*nv, M_, k_, cosines+r*k_);
+			LinearShape(0.5*(1+g), x+(first+r)*nv, M_, f+(first+r)*M_);
 		}
-		if (m > 0)
-			product *= sin(x[i]*MathAux::PI/2);
-		
-		f[m] = product;
 	}
-
 	return true;
+}
+// ----------------------------------------------------------------------
+void CProblemDTLZ1::EvaluateRow(const double *x, double *f) const
+{
+	double g = RastriginG(x, M_, k_, 0);
+	LinearShape(0.5*(1+g), x, M_, f);
 
-}// bool CProblemDTLZ2::Evaluate(CIndividual *indv) const
-
+}// CProblemDTLZ1::EvaluateRow()
 
 
 
 
 // ----------------------------------------------------------------------
-//		CProblemDTLZ3
+//		CProblemDTLZ2
 // ----------------------------------------------------------------------
-bool CProblemDTLZ3::Evaluate(CIndividual *indv) const
+bool CProblemDTLZ2::EvaluateBatch(CPopulation *pop, size_t begin, size_t end) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
+	const double *x = 0;
+	double *f = 0;
+	if (!BatchRows(pop, begin, &x, &f)) return false;
 
-	if (x.size() != M_ + k_ - 1) return false; // #variables does not match
+	if (!SphericalBatch(x, f, end-begin, M_, k_, 1, false)) return BRowProblem::EvaluateBatch(pop, begin, end);
+	return true;
+}
+// ----------------------------------------------------------------------
+void CProblemDTLZ2::EvaluateRow(const double *x, double *f) const
+{
+	double g = SphereG(x, M_, k_);
+	SphericalShape(1+g, x, M_, 1, f);
+
+}// CProblemDTLZ2::EvaluateRow()
 
-	double g = 0;
-	for (size_t i = M_-1; i < x.size(); i += 1)
-	{
-		g += MathAux::square(x[i]-0.5) - cos(20*MathAux::PI*(x[i]-0.5));
-	}
-	g = (k_ + g)*100;
 
-	f.resize(M_, 0);
-	for (size_t m = 0; m < M_; m += 1)
-	{
-		double product = (1+g);
-		size_t i=0;
-		for (; i+m<=M_-2; i+=1)
-		{
-			product *= cos(x[i]*MathAux::PI/2);
-		}
-		if (m > 0)
-			product *= sin(x[i]*MathAux::PI/2);
-		
-		f[m] = product;
-	}
 
+
+
+// ----------------------------------------------------------------------
+//		CProblemDTLZ3
+// ----------------------------------------------------------------------
+bool CProblemDTLZ3::EvaluateBatch(CPopulation *pop, size_t begin, size_t end) const
+{
+	const double *x = 0;
+	double *f = 0;
+	if (!BatchRows(pop, begin, &x, &f)) return false;
+
+	if (!SphericalBatch(x, f, end-begin, M_, k_, 1, true)) return BRowProblem::EvaluateBatch(pop, begin, end);
 	return true;
+}
+// ----------------------------------------------------------------------
+void CProblemDTLZ3::EvaluateRow(const double *x, double *f) const
+{
+	double g = RastriginG(x, M_, k_, 0);
+	SphericalShape(1+g, x, M_, 1, f);
 
-}// bool CProblemDTLZ3::Evaluate(CIndividual *indv) const
+}// CProblemDTLZ3::EvaluateRow()
 
 
 
@@ -146,37 +251,22 @@ bool CProblemDTLZ3::Evaluate(CIndividual *indv) const
 // ----------------------------------------------------------------------
 //		CProblemDTLZ4
 // ----------------------------------------------------------------------
-bool CProblemDTLZ4::Evaluate(CIndividual *indv) const
+bool CProblemDTLZ4::EvaluateBatch(CPopulation *pop, size_t begin, size_t end) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != M_ + k_ - 1) return false; // #variables does not match
-
-	double g = 0;
-	for (size_t i = M_-1; i < x.size(); i += 1)
-	{
-		g += MathAux::square(x[i]-0.5);
-	}
-
-	f.resize(M_, 0);
-	for (size_t m = 0; m < M_; m += 1)
-	{
-		double product = (1+g);
-		size_t i=0;
-		for (; i+m<=M_-2; i+=1)
-		{
-			product *= cos( pow(x[i], alpha_)*MathAux::PI/2 );
-		}
-		if (m > 0)
-			product *= sin( pow(x[i], alpha_)*MathAux::PI/2 );
-		
-		f[m] = product;
-	}
+	const double *x = 0;
+	double *f = 0;
+	if (!BatchRows(pop, begin, &x, &f)) return false;
 
+	if (!SphericalBatch(x, f, end-begin, M_, k_, alpha_, false)) return BRowProblem::EvaluateBatch(pop, begin, end);
 	return true;
+}
+// ----------------------------------------------------------------------
+void CProblemDTLZ4::EvaluateRow(const double *x, double *f) const
+{
+	double g = SphereG(x, M_, k_);
+	SphericalShape(1+g, x, M_, alpha_, f);
 
-}// bool CProblemDTLZ4::Evaluate(CIndividual *indv) const
+}// CProblemDTLZ4::EvaluateRow()
 
 
 
@@ -185,27 +275,21 @@ bool CProblemDTLZ4::Evaluate(CIndividual *indv) const
 // ----------------------------------------------------------------------
 //		CProblemDTLZ5
 // ----------------------------------------------------------------------
-bool CProblemDTLZ5::Evaluate(CIndividual *indv) const
+void CProblemDTLZ5::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != M_ + k_ - 1) return false; // #variables does not match
-
 	double g = 0;
-	for (size_t i = M_-1; i < x.size(); i += 1)
+	for (size_t i = M_-1; i < M_+k_-1; i += 1)
 	{
 		g += MathAux::square(x[i]-0.5);
 	}
 
-	std::vector<double> theta(x.size());
+	std::vector<double> theta(M_+k_-1);
 	theta[0] = x[0]*MathAux::PI/2.0; 
 	for (size_t i=1; i<theta.size(); i+=1)
 	{
 		theta[i] = MathAux::PI/(4*(1+g))*(1+2*g*x[i]);
 	}
 
-	f.resize(M_, 0);
 	for (size_t m = 0; m < M_; m += 1)
 	{
 		double product = (1+g);
@@ -220,9 +304,7 @@ bool CProblemDTLZ5::Evaluate(CIndividual *indv) const
 		f[m] = product;
 	}
 
-	return true;
-
-}// bool CProblemDTLZ5::Evaluate(CIndividual *indv) const
+}// CProblemDTLZ5::EvaluateRow()
 
 
 
@@ -230,28 +312,22 @@ bool CProblemDTLZ5::Evaluate(CIndividual *indv) const
 // ----------------------------------------------------------------------
 //		CProblemDTLZ6
 // ----------------------------------------------------------------------
-bool CProblemDTLZ6::Evaluate(CIndividual *indv) const
+void CProblemDTLZ6::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != M_ + k_ - 1) return false; // #variables does not match
-
 	double g = 0;
-	for (size_t i = M_-1; i < x.size(); i += 1)
+	for (size_t i = M_-1; i < M_+k_-1; i += 1)
 	{
 		g += pow(x[i], 0.1);
 	}
 
 	// the following is the same as DTLZ5
-	std::vector<double> theta(x.size());
+	std::vector<double> theta(M_+k_-1);
 	theta[0] = x[0]*MathAux::PI/2.0; 
 	for (size_t i=1; i<theta.size(); i+=1)
 	{
 		theta[i] = MathAux::PI/(4*(1+g))*(1+2*g*x[i]);
 	}
 
-	f.resize(M_, 0);
 	for (size_t m = 0; m < M_; m += 1)
 	{
 		double product = (1+g);
@@ -266,9 +342,7 @@ bool CProblemDTLZ6::Evaluate(CIndividual *indv) const
 		f[m] = product;
 	}
 
-	return true;
-
-}// bool CProblemDTLZ6::Evaluate(CIndividual *indv) const
+}// CProblemDTLZ6::EvaluateRow()
 
 
 
@@ -277,20 +351,15 @@ bool CProblemDTLZ6::Evaluate(CIndividual *indv) const
 // ----------------------------------------------------------------------
 //		CProblemDTLZ7
 // ----------------------------------------------------------------------
-bool CProblemDTLZ7::Evaluate(CIndividual *indv) const
+void CProblemDTLZ7::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != M_ + k_ - 1) return false; // #variables does not match
-
 	for (size_t m = 0; m < M_-1; m += 1)
 	{
 		f[m] = x[m];
 	}
 
 	double g = 0;
-	for (size_t i = M_-1; i < x.size(); i += 1)
+	for (size_t i = M_-1; i < M_+k_-1; i += 1)
 	{
 		g += x[i];
 	}
@@ -304,6 +373,4 @@ bool CProblemDTLZ7::Evaluate(CIndividual *indv) const
 
 	f[M_-1] = (1+g)*h;
 
-	return true;
-
-}// bool CProblemDTLZ7::Evaluate(CIndividual *indv) const
+}// CProblemDTLZ7::EvaluateRow()
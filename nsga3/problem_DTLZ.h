@@ -15,7 +15,7 @@
 //
 // http://link.springer.com/content/pdf/10.1007%2F1-84628-137-7.pdf
 // ----------------------------------------------------------------------
-class CProblemDTLZ : public BProblem
+class CProblemDTLZ : public BRowProblem
 {
 public:
 	CProblemDTLZ(std::size_t M, std::size_t k, const std::string &name);
@@ -23,8 +23,6 @@ public:
 	virtual std::size_t num_variables() const { return M_+k_-1; }
 	virtual std::size_t num_objectives() const { return M_; }
 
-	virtual bool Evaluate(CIndividual *indv) const = 0;
-
 protected:
 	std::size_t M_; // number of objectives
 	std::size_t k_; // number of variables in g(xM)
@@ -39,7 +37,10 @@ class CProblemDTLZ1 : public CProblemDTLZ
 {
 public:
 	explicit CProblemDTLZ1(std::size_t M, std::size_t k = 5):CProblemDTLZ(M, k, "DTLZ1") {}
-	virtual bool Evaluate(CIndividual *indv) const;
+	virtual bool EvaluateBatch(CPopulation *pop, std::size_t begin, std::size_t end) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 
@@ -51,7 +52,10 @@ class CProblemDTLZ2 : public CProblemDTLZ
 {
 public:
 	explicit CProblemDTLZ2(std::size_t M, std::size_t k = 10):CProblemDTLZ(M, k, "DTLZ2") {}
-	virtual bool Evaluate(CIndividual *indv) const;
+	virtual bool EvaluateBatch(CPopulation *pop, std::size_t begin, std::size_t end) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 
@@ -63,7 +67,10 @@ class CProblemDTLZ3 : public CProblemDTLZ
 {
 public:
 	explicit CProblemDTLZ3(std::size_t M, std::size_t k = 10):CProblemDTLZ(M, k, "DTLZ3") {}
-	virtual bool Evaluate(CIndividual *indv) const;
+	virtual bool EvaluateBatch(CPopulation *pop, std::size_t begin, std::size_t end) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 
@@ -75,7 +82,10 @@ class CProblemDTLZ4 : public CProblemDTLZ
 {
 public:
 	explicit CProblemDTLZ4(std::size_t M, std::size_t k = 10, double alpha = 100):CProblemDTLZ(M, k, "DTLZ4"), alpha_(alpha) {}
-	virtual bool Evaluate(CIndividual *indv) const;
+	virtual bool EvaluateBatch(CPopulation *pop, std::size_t begin, std::size_t end) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 
 private:
 	double alpha_;
@@ -91,7 +101,9 @@ class CProblemDTLZ5 : public CProblemDTLZ
 {
 public:
 	explicit CProblemDTLZ5(std::size_t M, std::size_t k = 10):CProblemDTLZ(M, k, "DTLZ5") {}
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 
@@ -103,7 +115,9 @@ class CProblemDTLZ6 : public CProblemDTLZ
 {
 public:
 	explicit CProblemDTLZ6(std::size_t M, std::size_t k = 10):CProblemDTLZ(M, k, "DTLZ6") {}
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 
@@ -115,7 +129,9 @@ class CProblemDTLZ7 : public CProblemDTLZ
 {
 public:
 	explicit CProblemDTLZ7(std::size_t M, std::size_t k = 20):CProblemDTLZ(M, k, "DTLZ7") {}
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 
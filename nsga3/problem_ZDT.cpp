@@ -1,5 +1,4 @@
 #include "problem_ZDT.h"
-#include "alg_individual.h"
 #include "aux_math.h"
 #include <cmath>
 #include <numeric>
@@ -18,26 +17,17 @@ CProblemZDT1::CProblemZDT1(std::size_t n):
 	ubs_.resize(num_variables_, 1.0); // upper bound 1.0
 }
 // ----------------------------------------------------------------------
-bool CProblemZDT1::Evaluate(CIndividual *indv) const
+void CProblemZDT1::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != num_variables_) return false; // #variables does not match
-
-	f.resize(num_objectives(), 0);
-
 	f[0] = x[0];
 
-	double g = accumulate(x.begin()+1, x.end(), 0.0);
+	double g = accumulate(x+1, x+num_variables_, 0.0);
 	g = 1 + 9*g/(num_variables_ - 1);
 
 	double h = 1 - sqrt(x[0]/g);
 	f[1] = g*h;
 
-	return true;
-
-}// bool CProblemZDT1::Evaluate(CIndividual *indv) const
+}// CProblemZDT1::EvaluateRow()
 
 
 
@@ -52,26 +42,17 @@ CProblemZDT2::CProblemZDT2(std::size_t n):
 	ubs_.resize(num_variables_, 1.0); // upper bound 1.0
 }
 // ----------------------------------------------------------------------
-bool CProblemZDT2::Evaluate(CIndividual *indv) const
+void CProblemZDT2::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != num_variables_) return false; // #variables does not match
-
-	f.resize(num_objectives(), 0);
-
 	f[0] = x[0];
 
-	double g = accumulate(x.begin()+1, x.end(), 0.0);
+	double g = accumulate(x+1, x+num_variables_, 0.0);
 	g = 1 + 9*g/(num_variables_ - 1);
 
 	double h = 1 - MathAux::square(x[0]/g);
 	f[1] = g*h;
 
-	return true;
-
-}// bool CProblemZDT2::Evaluate(CIndividual *indv) const
+}// CProblemZDT2::EvaluateRow()
 
 
 // ----------------------------------------------------------------------
@@ -85,26 +66,17 @@ CProblemZDT3::CProblemZDT3(std::size_t n):
 	ubs_.resize(num_variables_, 1.0); // upper bound 1.0
 }
 // ----------------------------------------------------------------------
-bool CProblemZDT3::Evaluate(CIndividual *indv) const
+void CProblemZDT3::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != num_variables_) return false; // #variables does not match
-
-	f.resize(num_objectives(), 0);
-
 	f[0] = x[0];
 
-	double g = accumulate(x.begin()+1, x.end(), 0.0);
+	double g = accumulate(x+1, x+num_variables_, 0.0);
 	g = 1 + 9*g/(num_variables_ - 1);
 
 	double h = 1 - sqrt(x[0]/g) - x[0]/g*sin(10*MathAux::PI*x[0]);
 	f[1] = g*h;
 
-	return true;
-
-}// bool CProblemZDT3::Evaluate(CIndividual *indv) const
+}// CProblemZDT3::EvaluateRow()
 
 
 
@@ -122,15 +94,8 @@ CProblemZDT4::CProblemZDT4(std::size_t n):
 	ubs_[0] = 1.0;
 }
 // ----------------------------------------------------------------------
-bool CProblemZDT4::Evaluate(CIndividual *indv) const
+void CProblemZDT4::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != num_variables_) return false; // #variables does not match
-
-	f.resize(num_objectives(), 0);
-
 	f[0] = x[0];
 
 	double g = 1 + 10*(num_variables_ - 1);
@@ -143,9 +108,7 @@ bool CProblemZDT4::Evaluate(CIndividual *indv) const
 	double h = 1 - sqrt(x[0]/g);
 	f[1] = g*h;
 
-	return true;
-
-}// bool CProblemZDT4::Evaluate(CIndividual *indv) const
+}// CProblemZDT4::EvaluateRow()
 
 
 // ----------------------------------------------------------------------
@@ -159,23 +122,14 @@ CProblemZDT6::CProblemZDT6(std::size_t n):
 	ubs_.resize(num_variables_, 1.0); // upper bound
 }
 // ----------------------------------------------------------------------
-bool CProblemZDT6::Evaluate(CIndividual *indv) const
+void CProblemZDT6::EvaluateRow(const double *x, double *f) const
 {
-	CIndividual::TDecVec &x = indv->vars();
-	CIndividual::TObjVec &f = indv->objs();
-
-	if (x.size() != num_variables_) return false; // #variables does not match
-
-	f.resize(num_objectives(), 0);
-
 	f[0] = 1 - exp(-4*x[0])*pow(sin(4*MathAux::PI*x[0]), 6);
 
-	double g = accumulate(x.begin()+1, x.end(), 0.0);
+	double g = accumulate(x+1, x+num_variables_, 0.0);
 	g = 1 + 9*pow(g/(num_variables_ - 1), 0.25);
 
 	double h = 1 - MathAux::square(f[0]/g);
 	f[1] = g*h;
 
-	return true;
-
-}// bool CProblemZDT6::Evaluate(CIndividual *indv) const
+}// CProblemZDT6::EvaluateRow()
@@ -12,11 +12,11 @@
 // Evolutionary Algorithms: Empirical Results," Evolutionary Computation,
 // vol. 8, no. 2, pp. 173-195, 2000.
 // ----------------------------------------------------------------------
-class CProblemZDT : public BProblem
+class CProblemZDT : public BRowProblem
 {
 public:
 	explicit CProblemZDT(std::size_t n, const std::string &name):
-	BProblem(name),
+	BRowProblem(name),
 	num_variables_(n)
 	{}
 
@@ -35,7 +35,9 @@ class CProblemZDT1 : public CProblemZDT
 {
 public:
 	explicit CProblemZDT1(std::size_t n = 30); // default setting in ZDT1
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 // ----------------------------------------------------------------------
@@ -45,7 +47,9 @@ class CProblemZDT2 : public CProblemZDT
 {
 public:
 	explicit CProblemZDT2(std::size_t n = 30); // default setting in ZDT2
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 // ----------------------------------------------------------------------
@@ -55,7 +59,9 @@ class CProblemZDT3 : public CProblemZDT
 {
 public:
 	explicit CProblemZDT3(std::size_t n = 30); // default setting in ZDT3
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 // ----------------------------------------------------------------------
@@ -65,7 +71,9 @@ class CProblemZDT4 : public CProblemZDT
 {
 public:
 	explicit CProblemZDT4(std::size_t n = 10); // default setting in ZDT4
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 
@@ -76,7 +84,9 @@ class CProblemZDT6 : public CProblemZDT
 {
 public:
 	explicit CProblemZDT6(std::size_t n = 10); // default setting in ZDT6
-	virtual bool Evaluate(CIndividual *indv) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const;
 };
 
 #endif
@@ -0,0 +1,51 @@
+#include "problem_base.h"
+#include "alg_individual.h"
+#include "alg_population.h"
+
+using std::size_t;
+
+// ----------------------------------------------------------------------
+bool BProblem::EvaluateBatch(CPopulation *pop, size_t begin, size_t end) const
+{
+	bool ok = true;
+	for (size_t i=begin; i<end; i+=1)
+	{
+		ok = Evaluate(&(*pop)[i]) && ok;
+	}
+	return ok;
+}
+// ----------------------------------------------------------------------
+bool BProblem::BatchRows(CPopulation *pop, size_t begin, const double **x, double **f) const
+{
+	if (pop->num_variables() != num_variables() || pop->num_objectives() != num_objectives()) return false; // #variables or #objectives does not match
+
+	*x = pop->vars_data() + begin*num_variables();
+	*f = pop->objs_data() + begin*num_objectives();
+	return true;
+}
+// ----------------------------------------------------------------------
+bool BRowProblem::Evaluate(CIndividual *indv) const
+{
+	CIndividual::TDecVec &x = indv->vars();
+	CIndividual::TObjVec &f = indv->objs();
+
+	if (x.size() != num_variables() || f.size() != num_objectives()) return false; // #variables or #objectives does not match
+
+	EvaluateRow(x.data(), f.data());
+	return true;
+}
+// ----------------------------------------------------------------------
+bool BRowProblem::EvaluateBatch(CPopulation *pop, size_t begin, size_t end) const
+{
+	const double *x = 0;
+	double *f = 0;
+	if (!BatchRows(pop, begin, &x, &f)) return false;
+
+	const size_t nv = num_variables(), M = num_objectives();
+	for (size_t i=begin; i<end; i+=1, x+=nv, f+=M)
+	{
+		EvaluateRow(x, f);
+	}
+	return true;
+}
+// ----------------------------------------------------------------------
@@ -8,6 +8,7 @@
 //		BProblem: the base class of problems (e.g. ZDT and DTLZ)
 // ----------------------------------------------------------------------
 class CIndividual;
+class CPopulation;
 
 class BProblem
 {
@@ -19,15 +20,43 @@ public:
 	virtual std::size_t num_objectives() const = 0;
 	virtual bool Evaluate(CIndividual *indv) const = 0;
 
+	// EvaluateBatch(): evaluate the individuals [begin, end) of a population in
+	// one call. The default calls Evaluate() for each of them. Return false if
+	// any of them could not be evaluated.
+	virtual bool EvaluateBatch(CPopulation *pop, std::size_t begin, std::size_t end) const;
+
 	const std::string & name() const { return name_; }
 	const std::vector<double> & lower_bounds() const { return lbs_; }
 	const std::vector<double> & upper_bounds() const { return ubs_; }
 
 protected:
+	// BatchRows(): the rows [begin, end) of the decision and objective matrices
+	// of a population. Return false if their sizes do not match the problem.
+	bool BatchRows(CPopulation *pop, std::size_t begin, const double **x, double **f) const;
+
 	std::string name_;
 
 	std::vector<double> lbs_, // lower bounds of variables 
 		                ubs_; // upper bounds of variables
 };
 
+// ----------------------------------------------------------------------
+//		BRowProblem: the base class of problems that are evaluated one row
+//		of the population matrices at a time (e.g. ZDT and DTLZ)
+//
+// Evaluate() and EvaluateBatch() both call EvaluateRow(). A problem only
+// overrides EvaluateBatch() when it has a kernel for a block of rows.
+// ----------------------------------------------------------------------
+class BRowProblem : public BProblem
+{
+public:
+	explicit BRowProblem(const std::string &name):BProblem(name) {}
+
+	virtual bool Evaluate(CIndividual *indv) const;
+	virtual bool EvaluateBatch(CPopulation *pop, std::size_t begin, std::size_t end) const;
+
+protected:
+	virtual void EvaluateRow(const double *x, double *f) const = 0; // x and f are rows of the population matrices
+};
+
 #endif
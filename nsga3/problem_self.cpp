@@ -18,7 +18,7 @@ bool CProblemSelf::Evaluate(CIndividual *indv) const
 	CIndividual::TDecVec &x = indv->vars();
 	CIndividual::TObjVec &f = indv->objs();
 
-	if (x.size() != num_vars_) return false;
+	if (x.size() != num_vars_ || f.size() != num_objs_) return false;
 
 	// You can define your own problem here.
 	f[0] = x[0];